@@ -0,0 +1,57 @@
+# Writes OUTPUT with the engine version of the result cache. Run at build time so that every
+# commit gets its own version; uncommitted changes add a hash of the solver sources, and the
+# insertion methods compiled in are part of the version as well.
+#   cmake -DSOURCE_DIR=<repo> -DOUTPUT=<header> [-DMETHODS=<list>] -P engineVersion.cmake
+
+execute_process(COMMAND git rev-parse --short HEAD
+  WORKING_DIRECTORY ${SOURCE_DIR}
+  OUTPUT_VARIABLE version
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+  RESULT_VARIABLE git_result
+  ERROR_QUIET)
+
+if(git_result EQUAL 0 AND version)
+  execute_process(COMMAND git status --porcelain -- CMakeLists.txt cmake include src
+    WORKING_DIRECTORY ${SOURCE_DIR}
+    OUTPUT_VARIABLE changes
+    ERROR_QUIET)
+  set(dirty FALSE)
+  if(changes)
+    set(dirty TRUE)
+  endif()
+else()
+  # No git, the sources are all there is to tell builds apart
+  set(version "dev")
+  set(dirty TRUE)
+endif()
+
+if(dirty)
+  file(GLOB_RECURSE sources ${SOURCE_DIR}/include/*.hpp ${SOURCE_DIR}/src/*.cpp ${SOURCE_DIR}/cmake/*.cmake)
+  list(SORT sources)
+  set(content "")
+  foreach(source ${SOURCE_DIR}/CMakeLists.txt ${sources})
+    file(RELATIVE_PATH name ${SOURCE_DIR} ${source})
+    file(READ ${source} text)
+    string(APPEND content "${name}\n${text}\n")
+  endforeach()
+  string(SHA1 hash "${content}")
+  string(SUBSTRING ${hash} 0 12 hash)
+  set(version "${version}-dirty-${hash}")
+endif()
+
+if(METHODS)
+  string(SHA1 methods_hash "${METHODS}")
+  string(SUBSTRING ${methods_hash} 0 8 methods_hash)
+  set(version "${version}-m${methods_hash}")
+endif()
+
+set(header "#pragma once\n\n#define OPT_TRIANGULATION_VERSION \"${version}\"\n")
+
+# Only rewrite on a change, otherwise every build would recompile the cache
+set(old_header "")
+if(EXISTS ${OUTPUT})
+  file(READ ${OUTPUT} old_header)
+endif()
+if(NOT old_header STREQUAL header)
+  file(WRITE ${OUTPUT} "${header}")
+endif()
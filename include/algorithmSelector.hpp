@@ -0,0 +1,38 @@
+#pragma once
+
+#include "triangulation.hpp"
+
+// Cheap instance features the selector decides on
+struct SelectorFeatures {
+    int num_points;
+    bool convex;
+    bool axis_parallel;
+    int num_constraints;
+    bool closed_constraints;
+    double obtuse_ratio;   // initial obtuse triangles per input point
+};
+
+// One instance of the research corpus with the engine that won on it
+struct SelectorSample {
+    int num_points;
+    bool convex;
+    bool axis_parallel;
+    int num_constraints;
+    bool closed_constraints;
+    double obtuse_ratio;
+    const char* engine;
+};
+
+class AlgorithmSelector {
+public:
+    static SelectorFeatures extractFeatures(const CDT& cdt, const std::vector<Point>& boundary, const std::vector<std::pair<Point, Point>>& constraints);
+
+    // Weighted vote of the nearest samples of the compiled-in table. Only ls and sa win a sample of the
+    // research corpus, so ant is never selected; it runs with an explicit "ant" method or as a portfolio lane
+    static std::string select(const SelectorFeatures& features);
+
+    static std::string select(const CDT& cdt, const std::vector<Point>& boundary, const std::vector<std::pair<Point, Point>>& constraints);
+
+private:
+    static double distance(const SelectorFeatures& features, const SelectorSample& sample);
+};
@@ -1,15 +1,58 @@
-int find_best_method(CDT cdt, Face_handle face);
+#pragma once
 
-double local_search(CDT& cdt, std::vector<Point>& steinerPoints, int L);
+#include "triangulation.hpp"
+#include "triangulationMethod.hpp"
+#include "searchControl.hpp"
+#include "flatMesh.hpp"
+#include <map>
+
+// Best insertion on face and the obtuse count it leaves in best_obtuse_count, 6 if no method improves the mesh
+int find_best_method(FlatMesh& mesh, int face, Point& best_point, int& best_obtuse_count, const SearchControl& control);
+
+// Position of every Steiner point in the list of an engine that works on the CDT, kept up to date next
+// to the list so that the Steiner vertices of a face are found without scanning it
+typedef std::map<Point, int> SteinerIndex;
+
+SteinerIndex make_steiner_index(const std::vector<Point>& steinerPoints);
+
+// Steiner vertex of face and the position it is moved to, false if no Steiner vertex of face can move
+bool relocation_move(const CDT& cdt, Face_handle face, const SteinerIndex& steinerIndex, int& index, Point& target);
+
+// Move steinerPoints[index] to target by removing and re-inserting its vertex; false if it is on the hull,
+// on a constrained edge or target is outside its star
+bool relocate_steiner_point(CDT& cdt, std::vector<Point>& steinerPoints, int index, const Point& target);
+
+// Best move of a Steiner vertex of face on the flat mesh, returns the obtuse count after it or -1 if none can move
+int find_best_relocation(FlatMesh& mesh, int face, int& best_vertex, Point& best_point, const SearchControl& control);
+
+// round counts the rounds of the search (0 for a new one), a resumed run continues from its checkpoint
+double local_search(CDT& cdt, std::vector<Point>& steinerPoints, int L, SearchControl& control, int& round);
+
+// Keeps the width best partial solutions, stops once the best one has not improved for depth steps
+double beam_search(CDT& cdt, std::vector<Point>& steinerPoints, int width, int depth, SearchControl& control);
 
 double calculateEnergy(const CDT& cdt, double a, double b, const std::vector<Point> steinerPoints);
 
 double randomProbability();
 
-double simulated_annealing(CDT& cdt, std::vector<Point>& steinerPoints, double a, double b, int L);
+double randomProbability(std::mt19937& rng);
+
+// temperature starts the run (1 for a new one) and holds the temperature of the next round
+double simulated_annealing(CDT& cdt, std::vector<Point>& steinerPoints, double a, double b, int L, SearchControl& control, double& temperature);
 
-void evaluate_method(TriangulationMethod* method, double a, double b, int obtuseCountOld, int obtuseCountNew, std::vector<Point>& steinerPoints, double previousEnergy, CDT& newCdt);
+void evaluate_method(TriangulationMethod* method, double a, double b, int obtuseCountOld, int obtuseCountNew, int steinerCount, AntMove& move);
 
 void update_pheromones(TriangulationMethod* method, double pheromonesEvaporation);
 
-double ant_colonies(CDT& cdt, std::vector<Point>& steinerPoints, double a, double b, double x , double y, double lambda, double kappa, int L);
\ No newline at end of file
+// cycle and the pheromones of the methods are kept up to date for a checkpoint, empty pheromones start a new colony
+double ant_colonies(CDT& cdt, std::vector<Point>& steinerPoints, double a, double b, double x , double y, double lambda, double kappa, int L, SearchControl& control,
+                    int& cycle, std::vector<double>& pheromones);
+
+// Replace the lazy construction history of the triangulation points by their exact values
+void materialize_points(CDT& cdt, std::vector<Point>& steinerPoints);
+
+// Flip non-constrained edges while that removes obtuse triangles or lowers the largest angle, returns the number of flips
+int flip_edges(CDT& cdt);
+
+// Remove Steiner points whose removal does not increase the obtuse count, returns how many were removed
+int prune_steiner_points(CDT& cdt, std::vector<Point>& steinerPoints);
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "triangulation.hpp"
+#include <iosfwd>
+
+// State of a suspended run: the Steiner points in insertion order, the engine with its
+// parameters and its own state (Optimizer::state), how far it got and the state of its random
+// number generator
+struct Checkpoint {
+    std::string instance_uid;
+    int num_points;
+    std::string engine;
+    nlohmann::json parameters;
+    nlohmann::json state;
+    int iterations;
+    double elapsed;
+    std::string rng_state;
+    std::vector<Point> steiner_points;
+};
+
+class CheckpointUtils {
+public:
+    static void writeCheckpoint(const std::string& filename, const Checkpoint& checkpoint);
+
+    static Checkpoint readCheckpoint(const std::string& filename);
+
+private:
+    static void writeString(std::ostream& out, const std::string& value);
+    static std::string readString(std::istream& in);
+
+    // Exact coordinates as sign and magnitude bytes of numerator and denominator
+    static void writeRational(std::ostream& out, const FT& value);
+    static FT readRational(std::istream& in);
+};
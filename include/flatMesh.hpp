@@ -0,0 +1,88 @@
+#pragma once
+
+#include "triangulation.hpp"
+
+// Array based copy of the finite faces of a CDT for the optimization inner loops.
+// Faces are stored as consecutive triples (counter-clockwise vertices, neighbour opposite
+// each vertex, constraint bit of each edge) so scans are linear walks over memory.
+class FlatMesh {
+public:
+    enum Location { INSIDE, ON_EDGE, ON_VERTEX, OUTSIDE };
+
+    // Vertices at steinerPoints[i] get Steiner index i, all others -1
+    static FlatMesh fromCdt(const CDT& cdt, const std::vector<Point>& steinerPoints = {});
+
+    inline int numberOfVertices() const { return points.size(); }
+    inline int numberOfFaces() const { return faceVertices.size() / 3; }
+    inline const Point& point(int vertex) const { return points[vertex]; }
+    // Position of the vertex in the Steiner point list of the engine, -1 for input points
+    inline int steinerIndex(int vertex) const { return steinerIndices[vertex]; }
+    inline int vertex(int face, int i) const { return faceVertices[3 * face + i]; }
+    inline int neighbor(int face, int i) const { return faceNeighbors[3 * face + i]; }
+    inline bool isConstrained(int face, int i) const { return (faceConstraints[face] >> i) & 1; }
+    inline bool isObtuse(int face) const { return faceObtuse[face]; }
+    inline int countObtuse() const { return obtuseCount; }
+
+    // Index of the neighbour slot of face that points back to other
+    int indexOf(int face, int other) const;
+
+    Location locate(const Point& p, int& face, int& index, int hint = 0) const;
+
+    // Constrained Delaunay insertion of the Steiner point with index steiner; returns false if p lies
+    // outside the mesh or on a vertex
+    bool insertPoint(const Point& p, int hint = 0, int steiner = -1);
+
+    // Flip the edge opposite vertex i of face; returns false if it is constrained, on the hull or not convex
+    bool flip(int face, int i);
+
+    // Faces around vertex i of face in counter-clockwise order, false if the vertex is on the hull or a constrained edge
+    bool star(int face, int i, std::vector<int>& faces) const;
+
+    // Move vertex i of face to p and restore the Delaunay property around it; returns false if the
+    // vertex cannot move (see star) or p is not in the kernel of its star
+    bool moveVertex(int face, int i, const Point& p);
+
+    // Replace the lazy construction history of the points by their exact values
+    void materializePoints();
+
+    // Trials record every change so that they can be undone in time proportional to the change
+    void beginTrial();
+    void rollback();
+    void commit();
+
+private:
+    struct FaceRecord {
+        int face;
+        int vertices[3];
+        int neighbors[3];
+        unsigned char constraints;
+        unsigned char obtuse;
+    };
+
+    int addFace();
+    void setFace(int face, int v0, int v1, int v2, int n0, int n1, int n2, unsigned char constraints);
+    void setNeighbor(int face, int i, int other);
+    void replaceNeighbor(int face, int oldNeighbor, int newNeighbor);
+    void updateObtuse(int face);
+    Location classify(const Point& p, int f, int& face, int& index) const;
+    void saveFace(int face);
+    void legalize(std::vector<std::pair<int, int>>& edges);
+    void restoreDelaunay(std::vector<std::pair<int, int>>& edges);
+    void splitFace(int face, int vertex);
+    void splitEdge(int face, int i, int vertex);
+
+    std::vector<Point> points;
+    std::vector<int> steinerIndices;
+    std::vector<int> faceVertices;
+    std::vector<int> faceNeighbors;
+    std::vector<unsigned char> faceConstraints;
+    std::vector<unsigned char> faceObtuse;
+    int obtuseCount = 0;
+
+    bool recording = false;
+    std::vector<FaceRecord> journal;
+    std::vector<std::pair<int, Point>> movedPoints;
+    size_t savedVertices = 0;
+    size_t savedFaces = 0;
+    int savedObtuseCount = 0;
+};
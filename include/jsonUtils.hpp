@@ -1,11 +1,22 @@
 #pragma once
 
 #include "./triangulation.hpp"
-#include <CGAL/draw_triangulation_2.h>
 
 class JsonUtils {
 public:
     static InputData parseInputJson(const std::string&);
 
+    static InputData parseInput(const nlohmann::json&);
+
+    // Engine settings of input_data.parameters with their defaults
+    static void readParameters(InputData&);
+
     static void writeOutputJson(const std::string&, const OutputData&);
+
+    static nlohmann::json toJson(const OutputData&);
+
+    // Steiner points of a JSON or binary solution file, coordinates are exact "num/den" strings or integers
+    static std::vector<Point> parseSolutionSteinerPoints(const std::string&);
+
+    static FT parseRational(const nlohmann::json&);
 };
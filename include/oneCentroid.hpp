@@ -7,6 +7,8 @@ class oneCentroidMethod : public TriangulationMethod {
 public:
     oneCentroidMethod();
     
+    bool steinerPoint(const CDT& cdt, Face_handle face, Point& point) override;
+
     void execute(CDT& cdt,Face_handle face , std::vector<Point>& steiner_points) override;
 
     double antColoniesHeuristic(CDT& cdt, Face_handle face, FT radiusToHeightRatio) override;
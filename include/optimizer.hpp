@@ -0,0 +1,220 @@
+#pragma once
+
+#include "triangulation.hpp"
+#include "searchControl.hpp"
+#include "tileDecomposition.hpp"
+#include <functional>
+#include <map>
+#include <memory>
+
+struct OptimizerResult {
+    std::string engine;
+    nlohmann::json parameters;
+    double convergence_rate;
+    int obtuse_count;
+    int steiner_count;
+    int iterations;
+    double energy;
+    double elapsed;
+    long rss_kb;        // resident memory at the end of the run, -1 if unknown
+    long peak_rss_kb;   // peak resident memory of the process, -1 if unknown
+    double time_to_target; // seconds until the target obtuse count was reached, -1 if never or no target
+    std::vector<TelemetrySample> telemetry;  // empty unless SearchControl::setTelemetry was called
+};
+
+// Common interface of the optimization engines (local search, simulated annealing, ant colonies, ...)
+class Optimizer {
+public:
+    virtual ~Optimizer() = default;
+
+    virtual std::string name() const = 0;
+
+    // Budget in seconds used when the input does not set one
+    virtual double defaultTimeLimit() const = 0;
+
+    // Parameters reported in the output file
+    virtual nlohmann::json parameters() const = 0;
+
+    virtual OptimizerResult run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) = 0;
+
+    // True if a checkpoint of the engine can be resumed, see state() and restore()
+    virtual bool resumable() const { return false; }
+
+    // What a resumed run needs besides the Steiner points and the random generator, kept up to date during run()
+    virtual nlohmann::json state() const { return nullptr; }
+
+    // Continue a checkpointed run with its parameters() and state()
+    virtual void restore(const nlohmann::json& parameters, const nlohmann::json& state) {}
+
+protected:
+    OptimizerResult makeResult(const CDT& cdt, const std::vector<Point>& steinerPoints, const SearchControl& control, double convergenceRate) const;
+};
+
+class LocalSearchOptimizer : public Optimizer {
+public:
+    explicit LocalSearchOptimizer(const InputData& input_data);
+
+    std::string name() const override { return "ls"; }
+    double defaultTimeLimit() const override { return 60.0; }
+    nlohmann::json parameters() const override;
+    OptimizerResult run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) override;
+    bool resumable() const override { return true; }
+    nlohmann::json state() const override;
+    void restore(const nlohmann::json& parameters, const nlohmann::json& state) override;
+
+private:
+    int L;
+    int round;   // rounds done
+};
+
+class SimulatedAnnealingOptimizer : public Optimizer {
+public:
+    explicit SimulatedAnnealingOptimizer(const InputData& input_data);
+
+    std::string name() const override { return "sa"; }
+    double defaultTimeLimit() const override { return 80.0; }
+    nlohmann::json parameters() const override;
+    OptimizerResult run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) override;
+    bool resumable() const override { return true; }
+    nlohmann::json state() const override;
+    void restore(const nlohmann::json& parameters, const nlohmann::json& state) override;
+
+private:
+    double alpha;
+    double beta;
+    int L;
+    double temperature;   // of the next round
+};
+
+class AntColonyOptimizer : public Optimizer {
+public:
+    explicit AntColonyOptimizer(const InputData& input_data);
+
+    std::string name() const override { return "ant"; }
+    double defaultTimeLimit() const override { return 60.0; }
+    nlohmann::json parameters() const override;
+    OptimizerResult run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) override;
+    bool resumable() const override { return true; }
+    nlohmann::json state() const override;
+    void restore(const nlohmann::json& parameters, const nlohmann::json& state) override;
+
+private:
+    double alpha;
+    double beta;
+    double xi;
+    double psi;
+    double lambda;
+    double kappa;
+    int L;
+    int cycle;                        // cycles done
+    std::vector<double> pheromones;   // of the insertion methods, empty before the first cycle
+};
+
+// Beam of partial solutions expanded with every insertion and relocation move, see beam_search
+class BeamSearchOptimizer : public Optimizer {
+public:
+    explicit BeamSearchOptimizer(const InputData& input_data);
+
+    std::string name() const override { return "beam"; }
+    double defaultTimeLimit() const override { return 60.0; }
+    nlohmann::json parameters() const override;
+    OptimizerResult run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) override;
+
+private:
+    int width;   // upper bound, the beam narrows when the budget runs short
+    int depth;   // steps without improvement before the search stops
+};
+
+// Only flips edges, no Steiner points are added
+class FlipOptimizer : public Optimizer {
+public:
+    explicit FlipOptimizer(const InputData& input_data);
+
+    std::string name() const override { return "flip"; }
+    double defaultTimeLimit() const override { return 60.0; }
+    nlohmann::json parameters() const override;
+    OptimizerResult run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) override;
+};
+
+// Constructive solution for axis-parallel domains, handed to another engine as a warm start if obtuse triangles remain
+class OrthoOptimizer : public Optimizer {
+public:
+    explicit OrthoOptimizer(const InputData& input_data);
+
+    std::string name() const override { return "ortho"; }
+    double defaultTimeLimit() const override { return 60.0; }
+    nlohmann::json parameters() const override;
+    OptimizerResult run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) override;
+
+private:
+    InputData input_data;
+    std::vector<Point> boundary;
+    std::string then;   // engine that continues from the construction, "none" to stop there
+};
+
+// Runs several engines concurrently on copies of the triangulation and keeps the best one
+class PortfolioOptimizer : public Optimizer {
+public:
+    explicit PortfolioOptimizer(const InputData& input_data);
+
+    std::string name() const override { return "portfolio"; }
+    double defaultTimeLimit() const override { return 60.0; }
+    nlohmann::json parameters() const override;
+    OptimizerResult run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) override;
+
+private:
+    InputData input_data;
+    std::vector<std::string> engines;
+};
+
+// Optimizes the tiles of a domain decomposition in parallel, inserts their Steiner points
+// into the whole triangulation and hands the obtuse triangles left along the seams to the engine
+class TiledOptimizer : public Optimizer {
+public:
+    explicit TiledOptimizer(const InputData& input_data);
+
+    std::string name() const override { return "tiles"; }
+    double defaultTimeLimit() const override { return 120.0; }
+    nlohmann::json parameters() const override;
+    OptimizerResult run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) override;
+
+protected:
+    // Tiles that are optimized independently, tileOf maps their faces to the tile index
+    virtual std::vector<TileDecomposition::Tile> decompose(const CDT& cdt, std::map<Face_handle, int>& tileOf) const;
+
+    InputData input_data;
+    int tileSize;         // faces per tile
+    std::string engine;   // engine run on every tile and on the seams
+};
+
+// Tiles are the connected clusters of obtuse faces with a halo of faces around them, the
+// faces far from any obtuse triangle are left out of the parallel stage
+class ClusterOptimizer : public TiledOptimizer {
+public:
+    explicit ClusterOptimizer(const InputData& input_data);
+
+    std::string name() const override { return "clusters"; }
+    nlohmann::json parameters() const override;
+
+protected:
+    std::vector<TileDecomposition::Tile> decompose(const CDT& cdt, std::map<Face_handle, int>& tileOf) const override;
+
+private:
+    int halo;   // rings of faces around each cluster
+};
+
+class OptimizerRegistry {
+public:
+    typedef std::function<std::unique_ptr<Optimizer>(const InputData&)> Factory;
+
+    static void registerOptimizer(const std::string& name, Factory factory);
+
+    static bool contains(const std::string& name);
+
+    static std::unique_ptr<Optimizer> create(const std::string& name, const InputData& input_data);
+
+    static std::vector<std::string> names();
+
+private:
+    static std::map<std::string, Factory>& factories();
+};
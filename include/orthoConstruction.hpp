@@ -0,0 +1,31 @@
+#pragma once
+
+#include "triangulation.hpp"
+
+// Constructive triangulation of axis-parallel domains. Every input point is extended by
+// horizontal and vertical chords up to the boundary; the chords cut the domain into empty
+// rectangles. A rectangle with nodes only at its corners is split into two right triangles,
+// chord ends on its sides (T-junctions) give non-right triangles that the engine run after
+// the construction has to remove.
+class OrthoConstruction {
+public:
+    static bool isApplicable(const std::vector<Point>& boundary);
+
+    // Inserts the chord intersections as Steiner points and triangulates along the chords, which are left
+    // unconstrained afterwards; returns the number of points added;
+    // 0 if the boundary is not axis-parallel or the coordinate grid is too large
+    static int construct(CDT& cdt, const std::vector<Point>& boundary, std::vector<Point>& steinerPoints);
+
+private:
+    struct Chord {
+        Point source;
+        Point target;
+    };
+
+    static std::vector<FT> distinctCoordinates(const CDT& cdt, bool x);
+
+    // Maximal runs of the grid line through every input point that stay inside the domain
+    static void collectChords(const CDT& cdt, const std::vector<FT>& xs, const std::vector<FT>& ys,
+                              const std::vector<std::vector<bool>>& inside, bool vertical,
+                              std::vector<Chord>& chords, std::vector<std::vector<bool>>& nodes);
+};
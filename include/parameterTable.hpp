@@ -0,0 +1,17 @@
+#pragma once
+
+#include "triangulation.hpp"
+
+// Tuned engine parameters by instance category (TriangulationUtils::getCategory), as written by
+// opt_triangulation_tune: { "<category>": { "<engine>": { "<parameter>": value, ... } } }
+class ParameterTable {
+public:
+    static nlohmann::json load(const std::string& filename);
+
+    static void write(const std::string& filename, const nlohmann::json& table);
+
+    static std::string category(const InputData& input_data);
+
+    // Fill the parameters of engine that the input leaves unset from the entry of its category, false if there is none
+    static bool apply(const nlohmann::json& table, const std::string& engine, InputData& input_data);
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "triangulation.hpp"
+#include <deque>
+
+struct TuningOptions {
+    std::vector<std::string> engines = { "ls", "sa", "ant" };
+    int configurations = 16;      // candidates per category and engine, the first one has the default parameters
+    double run_time = 10.0;       // time limit of a single run in seconds
+    double cpu_budget = 3600.0;   // CPU seconds of all runs together, every run uses one thread
+    int min_instances = 3;        // instances every candidate runs on before the first elimination
+    int threads = 1;
+    unsigned int seed = 1;
+    double a = 5.0;               // the score a * obtuse + b * steiner stays fixed while alpha and beta are tuned
+    double b = 1.0;
+};
+
+// A parameter of an engine, sampled uniformly (log-uniformly if logScale) in [low, high]
+struct TunedParameter {
+    std::string name;
+    double low;
+    double high;
+    bool integer;
+    bool logScale;
+    double defaultValue;
+};
+
+// Races parameter configurations of every engine on the instances of every category (F-race).
+// All candidates of a race run on the same instance with the same seed; after each instance the
+// candidates that are significantly worse than the best one (one-sided paired t-test at 95% on the
+// relative score) are dropped. The races share one pool of threads and stop once the CPU budget is spent.
+class ParameterTuner {
+public:
+    explicit ParameterTuner(const TuningOptions& options);
+
+    // Parameter table of the race winners (see ParameterTable), instances are grouped by ParameterTable::category
+    nlohmann::json tune(const std::vector<InputData>& instances);
+
+    // Tuned parameters of engine, empty if it has none
+    static const std::vector<TunedParameter>& space(const std::string& engine);
+
+    inline double getSpent() const { return spent; }
+
+private:
+    struct Candidate {
+        nlohmann::json parameters;
+        std::vector<double> scores;   // one per finished stage
+        bool alive = true;
+    };
+
+    struct Race {
+        std::string category;
+        std::string engine;
+        std::vector<const InputData*> instances;
+        std::vector<Candidate> candidates;
+        int stage = 0;     // index of the instance the alive candidates run on
+        int pending = 0;   // runs of the stage that have not finished
+    };
+
+    struct Run {
+        Race* race;
+        int candidate;
+    };
+
+    nlohmann::json sample(const std::string& engine, bool defaults, std::mt19937& rng) const;
+
+    // Score of one run, the largest double if the run fails
+    double evaluate(const InputData& instance, const std::string& engine, const nlohmann::json& parameters, unsigned int seed) const;
+
+    // Alive candidate with the lowest mean score relative to the best score of each instance
+    int best(const Race& race) const;
+
+    void eliminate(Race& race) const;
+
+    // Queue the runs of the current stage, false once the race is over; the caller holds the mutex
+    bool startStage(Race& race, std::deque<Run>& queue);
+
+    // One-sided 95% quantile of Student's t distribution
+    static double tCritical(int degrees);
+
+    TuningOptions options;
+    double spent;      // CPU seconds of finished runs
+    double reserved;   // budget of queued and running runs
+};
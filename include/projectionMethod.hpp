@@ -8,6 +8,8 @@ class ProjectionMethod : public TriangulationMethod {
 public:
     ProjectionMethod();
 
+    bool steinerPoint(const CDT& cdt, Face_handle face, Point& point) override;
+
     void execute(CDT& cdt, Face_handle face , std::vector<Point>& steiner_points) override;
 
     double antColoniesHeuristic(CDT& cdt, Face_handle face, FT radiusToHeightRatio) override;
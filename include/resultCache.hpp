@@ -0,0 +1,27 @@
+#pragma once
+
+#include "triangulation.hpp"
+#include <cstdint>
+
+// On-disk cache of output files keyed by the content of the instance, the resolved parameters,
+// the seed and the engine version written at build time by cmake/engineVersion.cmake. The least
+// recently used entries are evicted above the size cap.
+class ResultCache {
+public:
+    ResultCache(const std::string& directory, std::uintmax_t maxBytes);
+
+    static std::string key(const InputData& input_data);
+
+    // Copies the cached solution to outputFile, false on a miss
+    bool lookup(const std::string& key, const std::string& outputFile) const;
+
+    void store(const std::string& key, const std::string& outputFile);
+
+private:
+    std::string entryPath(const std::string& key) const;
+
+    void evict();
+
+    std::string directory;
+    std::uintmax_t maxBytes;
+};
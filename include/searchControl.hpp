@@ -0,0 +1,168 @@
+#pragma once
+
+#include "triangulation.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <string>
+
+// Receives the messages of a run, one line each; the engines of portfolio and tiled runs call it
+// from their worker threads
+typedef std::function<void(const std::string&)> LogCallback;
+
+// Passes the concatenated parts to callback, nothing is formatted without one
+template <class... Args>
+void log_message(const LogCallback& callback, const Args&... parts) {
+    if (!callback) return;
+    std::ostringstream message;
+    (message << ... << parts);
+    callback(message.str());
+}
+
+// Best energy shared between engines that race on the same instance (portfolio mode)
+struct SharedIncumbent {
+    std::atomic<double> bestEnergy{std::numeric_limits<double>::infinity()};
+    std::atomic<bool> stop{false};
+};
+
+// State of a run after begin() or an accepted step, see SearchControl::setTelemetry
+struct TelemetrySample {
+    double elapsed;
+    int iteration;
+    int obtuseCount;
+    int steinerCount;
+    double energy;
+};
+
+// Time budget, randomness and bookkeeping of a single optimizer run
+class SearchControl {
+public:
+    SearchControl(double timeLimit, unsigned int seed, double a, double b, SharedIncumbent* incumbent = nullptr);
+
+    // True once the time budget is spent
+    bool timeExceeded() const;
+
+    // True if the engine should stop: budget spent, stop requested or a rival engine is clearly ahead
+    bool shouldStop() const;
+
+    // Record the starting state of the triangulation
+    void begin(int obtuseCount, int steinerCount);
+
+    // Record the state of the triangulation after an accepted step
+    void report(int obtuseCount, int steinerCount);
+
+    void requestStop();
+
+    // Continue a run that was suspended after elapsedBefore seconds and iterationsBefore steps
+    void resume(double elapsedBefore, int iterationsBefore);
+
+    // Called from report() at most once every interval seconds, e.g. to write a checkpoint
+    void setCheckpoint(std::function<void()> callback, double interval);
+
+    // Called from report() at most once every interval seconds with the state of the run, e.g. to stream progress
+    void setProgress(std::function<void(const SearchControl&)> callback, double interval);
+
+    // Messages of the run go to callback, an empty one silences them
+    void setLog(LogCallback callback);
+
+    template <class... Args>
+    void log(const Args&... parts) const { log_message(logCallback, parts...); }
+
+    // The engine stops once flag is set by another thread, nullptr for none
+    void setCancellation(const std::atomic<bool>* flag);
+
+    // Round candidate Steiner points to a bounded denominator (0 disables it), see TriangulationUtils::snapPoint
+    void setSnapping(long denominator, bool grid);
+
+    // Snapped version of p, false if snapping is off or leaves p unchanged
+    bool snap(const Point& p, Point& snapped) const;
+
+    // Engines flatten their lazy exact points every interval reports (0 never)
+    void setMaterializeInterval(int interval);
+
+    // True once per interval reports, the engine should then materialize its points
+    bool materializeDue();
+
+    // The run reaches its target once the obtuse count drops to ratio times the count of the first begin() (negative: no target)
+    void setTarget(double ratio);
+
+    // Keep at most capacity samples of the run (0 disables it), every other one is dropped when it fills up
+    void setTelemetry(int capacity);
+
+    // Evenly thinned samples of the run and its latest state
+    std::vector<TelemetrySample> getTelemetry() const;
+
+    // Mean of |log(obtuse(n+1) / obtuse(n)) / log((n+1) / n)| over the steps that start and end with obtuse triangles, 0 without any
+    double getConvergenceRate() const;
+
+    // Resident set size and its peak in kB (VmRSS and VmHWM of /proc/self/status), false where unavailable
+    static bool memoryUsage(long& rssKb, long& peakKb);
+
+    double elapsed() const;
+
+    double remaining() const;
+
+    double energy(int obtuseCount, int steinerCount) const;
+
+    inline double getTimeLimit() const { return timeLimit; }
+    inline unsigned int getSeed() const { return seed; }
+    inline std::mt19937& getRng() { return rng; }
+    inline int getIterations() const { return iterations; }
+    inline double getCurrentEnergy() const { return currentEnergy; }
+    // Obtuse count of the last begin() or report(), -1 before the first one
+    inline int getObtuseCount() const { return lastObtuse; }
+    inline double getA() const { return a; }
+    inline double getB() const { return b; }
+    inline long getSnapDenominator() const { return snapDenominator; }
+    inline bool getSnapGrid() const { return snapGrid; }
+    inline int getMaterializeInterval() const { return materializeInterval; }
+    inline const LogCallback& getLog() const { return logCallback; }
+    inline const std::atomic<bool>* getCancellation() const { return cancellation; }
+    inline double getTargetRatio() const { return targetRatio; }
+    inline int getTelemetryCapacity() const { return telemetryCapacity; }
+    inline int getTargetObtuse() const { return targetObtuse; }
+    // Seconds until the target was first reached, -1 if it was not
+    inline double getTimeToTarget() const { return timeToTarget; }
+
+private:
+    void updateEnergy(double value);
+    void checkTarget(int obtuseCount);
+    void record(int obtuseCount, int steinerCount);
+
+    std::chrono::steady_clock::time_point startTime;
+    double timeLimit;
+    unsigned int seed;
+    double a;
+    double b;
+    std::mt19937 rng;
+    SharedIncumbent* incumbent;
+    std::atomic<bool> stopRequested;
+    int iterations;
+    double currentEnergy;
+    double elapsedBefore;
+    std::function<void()> checkpoint;
+    double checkpointInterval;
+    double lastCheckpoint;
+    std::function<void(const SearchControl&)> progress;
+    double progressInterval;
+    double lastProgress;
+    LogCallback logCallback;
+    const std::atomic<bool>* cancellation;
+    long snapDenominator;
+    bool snapGrid;
+    int materializeInterval;
+    int lastMaterialize;
+    double targetRatio;
+    int targetObtuse;
+    double timeToTarget;
+    int lastObtuse;
+    double convergenceSum;
+    int convergenceSteps;
+    int telemetryCapacity;
+    int telemetryStride;
+    long telemetrySeen;
+    std::vector<TelemetrySample> telemetry;
+    TelemetrySample latest;
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+// Generated by research_readme/fit_selector.py from research_readme/*_results.csv, do not edit
+
+#include "algorithmSelector.hpp"
+
+static const SelectorSample SELECTOR_TABLE[] = {
+    { 40, true, false, 40, true, 1.225000, "ls" }, // simple-polygon-exterior_40_ff947945
+    { 60, true, false, 60, true, 1.016667, "ls" }, // simple-polygon-exterior_60_8670ab75
+    { 10, true, false, 0, true, 0.500000, "sa" }, // point-set_10_7451a2a9
+    { 10, true, false, 0, true, 0.600000, "ls" }, // point-set_10_97578aae
+    { 10, true, false, 0, true, 0.600000, "sa" }, // point-set_10_ae0fff93
+    { 10, true, false, 0, true, 0.900000, "sa" }, // point-set_10_c04b0024
+    { 10, true, false, 0, true, 0.800000, "ls" }, // point-set_10_d009159f
+    { 10, true, false, 0, true, 1.000000, "ls" }, // point-set_10_f999dc7f
+    { 20, true, false, 0, true, 1.300000, "sa" }, // point-set_20_0c4009d9
+    { 20, true, false, 0, true, 1.150000, "ls" }, // point-set_20_34a047f7
+    { 20, true, false, 0, true, 1.000000, "ls" }, // point-set_20_41c48315
+    { 20, true, false, 0, true, 0.900000, "ls" }, // point-set_20_54ab0b47
+    { 20, true, false, 0, true, 0.750000, "sa" }, // point-set_20_5868538a
+    { 20, true, false, 0, true, 1.050000, "ls" }, // point-set_20_72cd2066
+    { 20, true, false, 0, true, 0.750000, "ls" }, // point-set_20_fa3fd7e0
+    { 40, true, false, 0, true, 1.000000, "ls" }, // point-set_40_1b92b629
+    { 40, true, false, 0, true, 0.750000, "ls" }, // point-set_40_8cbf31aa
+    { 40, true, false, 0, true, 0.850000, "ls" }, // point-set_40_9451c229
+    { 40, true, false, 0, true, 0.950000, "ls" }, // point-set_40_ae33a7ea
+    { 40, true, false, 0, true, 1.100000, "ls" }, // point-set_40_f511c8ce
+    { 60, true, false, 0, true, 1.083333, "ls" }, // point-set_60_27bc003d
+    { 60, true, false, 0, true, 1.200000, "ls" }, // point-set_60_2ff8f975
+    { 60, true, false, 0, true, 0.983333, "ls" }, // point-set_60_74409a1d
+    { 60, true, true, 0, true, 1.333333, "ls" }, // point-set_60_9fc02edd
+    { 60, true, false, 0, true, 1.066667, "ls" }, // point-set_60_ac318d72
+    { 80, true, false, 0, true, 0.675000, "ls" }, // point-set_80_1675b331
+    { 80, true, false, 0, true, 1.312500, "ls" }, // point-set_80_837b0f11
+    { 80, true, false, 0, true, 1.075000, "ls" }, // point-set_80_8383fead
+    { 80, true, false, 0, true, 0.437500, "ls" }, // point-set_80_9a8373fb
+    { 80, true, false, 0, true, 0.850000, "ls" }, // point-set_80_d77fb670
+    { 80, true, false, 0, true, 1.075000, "ls" }, // point-set_80_ff15444b
+    { 100, true, false, 0, true, 0.320000, "ls" }, // point-set_100_0245ce31
+    { 100, true, false, 0, true, 1.110000, "ls" }, // point-set_100_05594822
+    { 100, true, false, 0, true, 0.890000, "ls" }, // point-set_100_dd67678e
+    { 150, true, false, 0, true, 1.093333, "ls" }, // point-set_150_1fb326cf
+    { 150, true, false, 0, true, 0.786667, "ls" }, // point-set_150_20bcb550
+    { 150, true, false, 0, true, 1.320000, "ls" }, // point-set_150_982c9ab3
+    { 150, true, false, 0, true, 1.020000, "ls" }, // point-set_150_b26a2c80
+    { 250, true, false, 0, true, 1.028000, "ls" }, // point-set_250_3c338713
+    { 250, true, false, 0, true, 0.484000, "ls" }, // point-set_250_93dd622a
+    { 10, true, false, 7, false, 0.500000, "ls" }, // simple-polygon-exterior_10_310dc6c7
+    { 10, true, false, 7, false, 0.700000, "ls" }, // simple-polygon-exterior_10_40642b31
+    { 10, true, false, 8, false, 0.700000, "sa" }, // simple-polygon-exterior_10_74050e4d
+    { 10, true, false, 6, false, 0.900000, "ls" }, // simple-polygon-exterior_10_8b098f5e
+    { 10, true, false, 6, false, 0.700000, "ls" }, // simple-polygon-exterior_10_a5f0f2fc
+    { 10, true, false, 9, false, 1.200000, "sa" }, // simple-polygon-exterior_10_c5616894
+    { 20, true, false, 15, false, 0.800000, "sa" }, // simple-polygon-exterior_20_2a7302a0
+    { 20, true, false, 18, false, 0.800000, "ls" }, // simple-polygon-exterior_20_7520a1da
+    { 20, true, false, 16, false, 1.000000, "ls" }, // simple-polygon-exterior_20_87cff693
+    { 20, true, false, 16, false, 0.750000, "ls" }, // simple-polygon-exterior_20_92dcd467
+    { 20, true, false, 17, false, 1.050000, "ls" }, // simple-polygon-exterior_20_c820ed5d
+    { 20, true, false, 19, false, 1.250000, "ls" }, // simple-polygon-exterior_20_ff791267
+    { 40, true, false, 35, false, 1.125000, "ls" }, // simple-polygon-exterior_40_11434792
+    { 40, true, false, 37, false, 0.925000, "ls" }, // simple-polygon-exterior_40_7685a35e
+    { 40, true, false, 34, false, 0.825000, "ls" }, // simple-polygon-exterior_40_785575e7
+    { 40, true, false, 38, false, 1.125000, "sa" }, // simple-polygon-exterior_40_ca26cbd4
+    { 60, true, false, 56, false, 0.966667, "ls" }, // simple-polygon-exterior_60_1a49dffa
+    { 60, true, false, 56, false, 1.150000, "ls" }, // simple-polygon-exterior_60_494df14f
+    { 60, true, false, 58, false, 1.250000, "ls" }, // simple-polygon-exterior_60_881cf585
+    { 60, true, false, 58, false, 0.783333, "ls" }, // simple-polygon-exterior_60_ba2c82c0
+    { 80, true, false, 78, false, 1.112500, "ls" }, // simple-polygon-exterior_80_22d34c7e
+    { 80, true, false, 78, false, 1.087500, "ls" }, // simple-polygon-exterior_80_d87f15e8
+    { 100, true, false, 98, false, 1.210000, "ls" }, // simple-polygon-exterior_100_37aaf06f
+    { 100, true, false, 94, false, 1.110000, "ls" }, // simple-polygon-exterior_100_686dd044
+    { 100, true, false, 95, false, 1.010000, "ls" }, // simple-polygon-exterior_100_f1740925
+    { 150, true, false, 148, false, 1.093333, "ls" }, // simple-polygon-exterior_150_1301b82e
+    { 150, true, false, 146, false, 0.940000, "ls" }, // simple-polygon-exterior_150_89d077ac
+    { 150, true, false, 147, false, 1.173333, "ls" }, // simple-polygon-exterior_150_fb998503
+    { 250, true, false, 245, false, 1.120000, "ls" }, // simple-polygon-exterior_250_3f7ba0d3
+    { 250, true, false, 249, false, 1.036000, "ls" }, // simple-polygon-exterior_250_a97729dd
+    { 250, true, false, 247, false, 1.208000, "ls" }, // simple-polygon-exterior_250_c0a19392
+    { 10, true, false, 6, false, 0.700000, "sa" }, // simple-polygon-exterior-20_10_15783346
+    { 10, true, false, 6, false, 0.800000, "ls" }, // simple-polygon-exterior-20_10_46c44a43
+    { 10, true, false, 3, false, 0.600000, "ls" }, // simple-polygon-exterior-20_10_6fbd9669
+    { 10, true, false, 4, false, 0.700000, "sa" }, // simple-polygon-exterior-20_10_868921c7
+    { 10, true, false, 5, false, 0.800000, "sa" }, // simple-polygon-exterior-20_10_8c4306da
+    { 10, true, false, 7, false, 0.800000, "sa" }, // simple-polygon-exterior-20_10_c6728228
+    { 10, true, false, 3, false, 0.900000, "ls" }, // simple-polygon-exterior-20_10_ce9152de
+    { 20, true, false, 13, false, 0.950000, "sa" }, // simple-polygon-exterior-20_20_0f96fb2c
+    { 20, true, false, 14, false, 1.250000, "sa" }, // simple-polygon-exterior-20_20_1e719235
+    { 20, true, false, 11, false, 1.050000, "sa" }, // simple-polygon-exterior-20_20_4ddfa00e
+    { 20, true, false, 13, false, 1.200000, "ls" }, // simple-polygon-exterior-20_20_52abeef5
+    { 20, true, false, 15, false, 1.000000, "ls" }, // simple-polygon-exterior-20_20_c27f41dd
+    { 20, true, false, 17, false, 1.100000, "sa" }, // simple-polygon-exterior-20_20_e64ff8fc
+    { 20, true, false, 14, false, 1.050000, "sa" }, // simple-polygon-exterior-20_20_eb63a5b6
+    { 40, true, false, 30, false, 0.750000, "sa" }, // simple-polygon-exterior-20_40_317d3f6d
+    { 40, true, false, 31, false, 0.850000, "ls" }, // simple-polygon-exterior-20_40_5faf6985
+    { 40, true, false, 35, false, 1.025000, "ls" }, // simple-polygon-exterior-20_40_65de7236
+    { 40, true, false, 26, false, 0.900000, "ls" }, // simple-polygon-exterior-20_40_84415804
+    { 40, true, false, 30, false, 0.975000, "sa" }, // simple-polygon-exterior-20_40_8ad14096
+    { 40, true, false, 28, false, 1.175000, "ls" }, // simple-polygon-exterior-20_40_b9ab4f03
+    { 60, true, false, 42, false, 1.266667, "ls" }, // simple-polygon-exterior-20_60_28a85662
+    { 60, true, false, 50, false, 0.750000, "ls" }, // simple-polygon-exterior-20_60_53ad6d23
+    { 60, true, false, 40, false, 1.100000, "ls" }, // simple-polygon-exterior-20_60_57858065
+    { 60, true, false, 45, false, 1.066667, "ls" }, // simple-polygon-exterior-20_60_57cd1db6
+    { 60, true, false, 42, false, 0.966667, "ls" }, // simple-polygon-exterior-20_60_6088b7a9
+    { 60, true, false, 48, false, 1.216667, "ls" }, // simple-polygon-exterior-20_60_8221c868
+    { 60, true, false, 45, false, 1.366667, "ls" }, // simple-polygon-exterior-20_60_e6f13145
+    { 80, true, false, 58, false, 1.087500, "ls" }, // simple-polygon-exterior-20_80_1c5fcde7
+    { 80, true, false, 68, false, 1.075000, "ls" }, // simple-polygon-exterior-20_80_889602ae
+    { 100, true, false, 71, false, 0.650000, "ls" }, // simple-polygon-exterior-20_100_512f0fc4
+    { 100, true, false, 87, false, 1.130000, "ls" }, // simple-polygon-exterior-20_100_7ed1ca87
+    { 100, true, false, 72, false, 1.050000, "ls" }, // simple-polygon-exterior-20_100_8bfbe418
+    { 100, true, false, 76, false, 0.640000, "ls" }, // simple-polygon-exterior-20_100_8d1c2e30
+    { 100, true, false, 77, false, 1.090000, "ls" }, // simple-polygon-exterior-20_100_8ff7a64d
+    { 100, true, false, 80, false, 1.130000, "ls" }, // simple-polygon-exterior-20_100_c256488f
+    { 150, true, false, 120, false, 1.100000, "ls" }, // simple-polygon-exterior-20_150_41e0c5f0
+    { 150, true, false, 116, false, 1.073333, "ls" }, // simple-polygon-exterior-20_150_7768dd44
+    { 250, true, false, 200, false, 1.156000, "ls" }, // simple-polygon-exterior-20_250_0c9fa44e
+    { 250, true, false, 213, false, 0.992000, "ls" }, // simple-polygon-exterior-20_250_4441b4ca
+    { 250, true, false, 193, false, 1.132000, "ls" }, // simple-polygon-exterior-20_250_823ed1ae
+    { 250, true, false, 198, false, 1.012000, "ls" }, // simple-polygon-exterior-20_250_eb5ab92f
+    { 10, false, false, 0, true, 0.800000, "ls" }, // simple-polygon_10_272aa6ea
+    { 10, false, false, 0, true, 1.000000, "sa" }, // simple-polygon_10_297edd18
+    { 20, false, false, 0, true, 1.100000, "ls" }, // simple-polygon_20_0dda68ed
+    { 20, false, false, 0, true, 0.850000, "ls" }, // simple-polygon_20_35585ee3
+    { 20, false, false, 0, true, 0.900000, "ls" }, // simple-polygon_20_4bd3c2e5
+    { 40, false, false, 0, true, 0.900000, "ls" }, // simple-polygon_40_12969fc3
+    { 60, false, false, 0, true, 1.200000, "ls" }, // simple-polygon_60_0347cd75
+    { 60, false, false, 0, true, 1.016667, "ls" }, // simple-polygon_60_17af118a
+    { 80, false, false, 0, true, 1.112500, "ls" }, // simple-polygon_80_48c9df87
+    { 80, false, false, 0, true, 0.500000, "ls" }, // simple-polygon_80_7b8f6c4c
+    { 100, false, false, 0, true, 0.650000, "ls" }, // simple-polygon_100_4b4ba391
+    { 100, false, false, 0, true, 1.010000, "ls" }, // simple-polygon_100_4ee8f447
+    { 100, false, false, 0, true, 0.880000, "ls" }, // simple-polygon_100_6101abad
+    { 100, false, false, 0, true, 1.390000, "ls" }, // simple-polygon_100_cb23308c
+    { 150, false, false, 0, true, 1.153333, "ls" }, // simple-polygon_150_743d6b9c
+    { 150, false, false, 0, true, 1.320000, "ls" }, // simple-polygon_150_b42a5724
+    { 150, false, false, 0, true, 1.120000, "ls" }, // simple-polygon_150_c0cf1e9c
+    { 150, false, false, 0, true, 0.680000, "ls" }, // simple-polygon_150_f24b0f8e
+    { 250, false, false, 0, true, 0.996000, "ls" }, // simple-polygon_250_432b4814
+    { 250, false, false, 0, true, 0.496000, "ls" }, // simple-polygon_250_6e9d9c26
+    { 250, false, false, 0, true, 0.976000, "ls" }, // simple-polygon_250_c02755d7
+    { 10, false, true, 0, true, 0.400000, "ls" }, // ortho_10_d2723dcc
+    { 20, false, true, 0, true, 0.550000, "sa" }, // ortho_20_5a9e8244
+    { 20, false, true, 0, true, 0.500000, "ls" }, // ortho_20_e2aff192
+    { 40, false, true, 0, true, 0.950000, "ls" }, // ortho_40_56a6f463
+    { 40, false, true, 0, true, 0.600000, "ls" }, // ortho_40_df58ce3b
+    { 60, false, true, 0, true, 0.833333, "ls" }, // ortho_60_f744490d
+    { 60, false, true, 0, true, 0.833333, "ls" }, // ortho_60_c423f527
+    { 80, false, true, 0, true, 0.812500, "ls" }, // ortho_80_06ee55d4
+    { 100, false, true, 0, true, 0.850000, "ls" }, // ortho_100_bd1e4a14
+    { 150, false, true, 0, true, 0.886667, "ls" }, // ortho_150_53eb4022
+    { 250, false, true, 0, true, 0.912000, "ls" }, // ortho_250_3b977f7e
+    { 250, false, true, 0, true, 1.016000, "ls" }, // ortho_250_6e6a66c2
+};
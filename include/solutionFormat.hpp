@@ -0,0 +1,40 @@
+#pragma once
+
+#include "triangulation.hpp"
+#include <cstdint>
+#include <iosfwd>
+
+// Compact binary form of CG_SHOP_2025_Solution files. After a versioned header come the strings of
+// the solution, the Steiner coordinates as sign and length prefixed GMP integers, the edges as
+// varint deltas and the stats block; every other member is kept as CBOR. Converting a JSON
+// solution to binary and back gives the same JSON value, coordinates keep their exact spelling.
+class SolutionFormat {
+public:
+    // True if the file starts with the magic of the binary format
+    static bool isBinary(const std::string& filename);
+
+    static void write(const std::string& filename, const nlohmann::json& solution);
+
+    static nlohmann::json read(const std::string& filename);
+
+    // Solution in either format
+    static nlohmann::json load(const std::string& filename);
+
+    // Steiner points of a binary solution, built from the stored integers without the detour through decimal strings
+    static std::vector<Point> readSteinerPoints(const std::string& filename);
+
+private:
+    // Checks magic and version, returns the sections present in the file
+    static uint8_t readHeader(std::istream& in, const std::string& filename);
+
+    static void writeString(std::ostream& out, const std::string& value);
+    static std::string readString(std::istream& in);
+
+    // A coordinate is a JSON integer or a "num" or "num/den" string, anything else is stored verbatim
+    static void writeCoordinate(std::ostream& out, const nlohmann::json& value);
+    static nlohmann::json readCoordinate(std::istream& in);
+    static FT readExactCoordinate(std::istream& in);
+
+    static void writeBlock(std::ostream& out, const nlohmann::json& value);
+    static nlohmann::json readBlock(std::istream& in);
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "triangulation.hpp"
+#include <set>
+
+struct ValidationReport {
+    bool valid = true;
+    std::vector<std::string> errors;
+    std::vector<std::string> warnings;
+    int points = 0;
+    int edges = 0;
+    int faces = 0;             // finite faces of the triangulation the edges span
+    int region_faces = 0;      // faces inside the region boundary
+    int obtuse_count = 0;      // obtuse faces, counted like the solver does over all faces
+    int region_obtuse_count = 0;
+    int reported_obtuse_count = -1;
+    double elapsed = 0.0;
+};
+
+// Independent check of a solution file against its instance. The mesh is rebuilt from the
+// Steiner points and edges alone; faces are scored on threads sharing the face list.
+class SolutionValidator {
+public:
+    // strict turns edges outside the region into errors, the solver also outputs the hull faces around non-convex regions
+    static ValidationReport validate(const InputData& input_data, const nlohmann::json& solution, int threads, bool strict);
+
+private:
+    // Every point on segment ab splits it, each piece has to be an edge of the solution
+    static bool segmentCovered(const std::vector<Point>& points, int a, int b, const std::set<std::pair<int, int>>& edges, std::string& missing);
+};
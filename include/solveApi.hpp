@@ -0,0 +1,71 @@
+#pragma once
+
+// In-memory entry point of the solver, no files are read or written
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace opt_triangulation {
+
+// Read-only view of a contiguous array owned by the caller
+template <class T>
+class Span {
+public:
+    Span() : first(nullptr), count(0) {}
+    Span(const T* data, std::size_t size) : first(data), count(size) {}
+    Span(const std::vector<T>& values) : first(values.data()), count(values.size()) {}
+
+    inline const T* data() const { return first; }
+    inline std::size_t size() const { return count; }
+    inline bool empty() const { return count == 0; }
+    inline const T& operator[](std::size_t i) const { return first[i]; }
+    inline const T* begin() const { return first; }
+    inline const T* end() const { return first + count; }
+
+private:
+    const T* first;
+    std::size_t count;
+};
+
+// Instance over caller owned arrays; they must stay alive during solve(), which copies them into
+// the solver's own input
+struct InstanceView {
+    std::string instance_uid;
+    Span<int> points_x;
+    Span<int> points_y;
+    Span<int> region_boundary;   // indices of the boundary points in order
+    Span<int> constraints;       // pairs of point indices, two entries per constraint
+};
+
+struct SolveOptions {
+    std::string method = "auto";                            // engine name, "auto" lets the selector choose
+    bool delaunay = true;
+    nlohmann::json parameters = nlohmann::json::object();   // same keys as the "parameters" of an input file
+};
+
+struct SolveStats {
+    std::string method;
+    nlohmann::json parameters;
+    int obtuse_count = 0;
+    int steiner_count = 0;
+    int iterations = 0;
+    double energy = 0.0;
+    double convergence_rate = 0.0;
+    double elapsed = 0.0;
+};
+
+// Steiner points as exact "num/den" strings, their indices follow the input points
+struct Solution {
+    std::vector<std::string> steiner_x;
+    std::vector<std::string> steiner_y;
+    std::vector<int> edges;      // pairs of point indices, two entries per edge
+    SolveStats stats;
+};
+
+// Throws std::invalid_argument on mismatched coordinate arrays, odd constraint arrays,
+// boundary or constraint indices outside the points and constraints from a point to itself
+Solution solve(const InstanceView& instance, const SolveOptions& options);
+
+} // namespace opt_triangulation
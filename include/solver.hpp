@@ -0,0 +1,27 @@
+#pragma once
+
+#include "triangulation.hpp"
+#include "optimizer.hpp"
+#include <atomic>
+#include <functional>
+
+// Options of a run besides the input and output data
+struct RunOptions {
+    std::string warm_start;            // solution whose Steiner points the search starts from
+    std::string checkpoint;            // file the state is saved to during and after the run
+    std::string resume;                // checkpoint of a suspended run to continue
+    double checkpoint_interval = 30.0; // seconds between checkpoints
+    std::string cache;                 // result cache directory, empty to disable
+    double cache_size = 512.0;         // cap of the cache in MB
+    double max_time = 0.0;             // cap on the time budget in seconds, 0 for none
+    const std::atomic<bool>* cancel = nullptr;              // set by another thread to stop with the best solution so far
+    std::function<void(const SearchControl&)> progress;     // called with the state of the run every progress_interval seconds
+    double progress_interval = 1.0;
+    LogCallback log;                   // messages of the run (counts, memory, failed engines), silent when empty
+    nlohmann::json params;             // tuned parameters by category and engine (ParameterTable), null for none
+};
+
+std::vector<Point> constructBoundary(const InputData& input_data);
+
+// Optimize the triangulation of an instance and fill the solution into output_data, returns the run statistics
+OptimizerResult perform_triangulation(const InputData& input_data, OutputData& output_data, const RunOptions& options);
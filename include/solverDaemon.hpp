@@ -0,0 +1,79 @@
+#pragma once
+
+#include "triangulation.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Long running solver behind a Unix domain socket. Clients send one JSON request per line:
+//   {"op": "solve", "id": "a", "instance": {...}, "priority": 0, "deadline": 30, "progress": true}
+//   {"op": "cancel", "id": "a"}   {"op": "priority", "id": "a", "priority": 5}   {"op": "status"}   {"op": "shutdown"}
+// and get one JSON event per line back: queued, started, progress, done, cancelled, expired, status or error.
+// Jobs run on a pool of workers that stay warm between jobs; higher priorities go first, then earlier deadlines.
+class SolverDaemon {
+public:
+    // params is a tuned parameter table (ParameterTable) used by every job, null for none
+    SolverDaemon(const std::string& socketPath, int workers, const nlohmann::json& params = nlohmann::json());
+
+    SolverDaemon(const SolverDaemon&) = delete;
+    SolverDaemon& operator=(const SolverDaemon&) = delete;
+
+    // Serve until a shutdown request, returns the exit code of the process
+    int run();
+
+private:
+    struct Connection {
+        explicit Connection(int fd) : fd(fd) {}
+        ~Connection();
+
+        // Write one event line, errors of a client that went away are ignored
+        void send(const nlohmann::json& event);
+
+        int fd;
+        std::mutex writeMutex;
+        std::atomic<bool> open{true};
+        // Set as the last step of the connection thread, which can then be joined without blocking
+        std::atomic<bool> finished{false};
+    };
+
+    struct Job {
+        std::string id;
+        std::shared_ptr<Connection> connection;
+        InputData input;
+        int priority = 0;
+        bool hasDeadline = false;
+        std::chrono::steady_clock::time_point deadline;
+        bool progress = false;
+        long sequence = 0;
+        bool running = false;
+        std::atomic<bool> cancelled{false};
+    };
+
+    void serveConnection(std::shared_ptr<Connection> connection);
+    void handleRequest(const std::shared_ptr<Connection>& connection, const nlohmann::json& request);
+    void submit(const std::shared_ptr<Connection>& connection, const nlohmann::json& request);
+    void cancel(const std::shared_ptr<Connection>& connection, const std::string& id);
+    void cancelAll(const std::shared_ptr<Connection>& connection);
+
+    void workerLoop();
+    void runJob(const std::shared_ptr<Job>& job);
+
+    // Removes the most urgent job from the queue, the caller holds the mutex
+    std::shared_ptr<Job> takeNextJob();
+
+    std::string socketPath;
+    int workerCount;
+    nlohmann::json params;
+    int listenFd;
+    std::atomic<bool> stopping;
+
+    std::mutex mutex;
+    std::condition_variable available;
+    std::vector<std::shared_ptr<Job>> queue;
+    std::map<std::string, std::shared_ptr<Job>> jobs;   // queued and running jobs by id
+    long sequence;
+};
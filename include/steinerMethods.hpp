@@ -0,0 +1,125 @@
+#pragma once
+
+#include "triangulation.hpp"
+#include "triangulationUtils.hpp"
+#include "flatMesh.hpp"
+
+// Stateless candidate points of the insertion methods, on a face of the CGAL triangulation and of the
+// flat mesh. ID is the number find_best_method(FlatMesh&, ...) returns for the method; the
+// TriangulationMethod classes of the ant colonies delegate to these functions.
+
+struct ProjectionPoint {
+    static constexpr int ID = 1;
+
+    static inline bool point(const CDT& cdt, Face_handle face, Point& p) {
+        return TriangulationUtils::obtuseProjection(face->vertex(0)->point(), face->vertex(1)->point(), face->vertex(2)->point(), p);
+    }
+
+    static inline bool point(const FlatMesh& mesh, int face, Point& p) {
+        return TriangulationUtils::obtuseProjection(mesh.point(mesh.vertex(face, 0)), mesh.point(mesh.vertex(face, 1)), mesh.point(mesh.vertex(face, 2)), p);
+    }
+};
+
+struct MidpointPoint {
+    static constexpr int ID = 2;
+
+    static inline bool point(const CDT& cdt, Face_handle face, Point& p) {
+        p = TriangulationUtils::longestEdgeMidpoint(face->vertex(0)->point(), face->vertex(1)->point(), face->vertex(2)->point());
+        return true;
+    }
+
+    static inline bool point(const FlatMesh& mesh, int face, Point& p) {
+        p = TriangulationUtils::longestEdgeMidpoint(mesh.point(mesh.vertex(face, 0)), mesh.point(mesh.vertex(face, 1)), mesh.point(mesh.vertex(face, 2)));
+        return true;
+    }
+};
+
+// Centroid of the quadrilateral of the face and its first obtuse neighbour
+struct QuadrilateralCentroidPoint {
+    static constexpr int ID = 3;
+
+    static inline bool point(const CDT& cdt, Face_handle face, Point& p) {
+        if (cdt.is_infinite(face)) return false;
+
+        for (int i = 0; i < 3; ++i) {
+            Face_handle neighbor = face->neighbor(i);
+            if (cdt.is_infinite(neighbor) || !TriangulationUtils::isObtuseTriangle(cdt.triangle(neighbor))) continue;
+
+            int j = neighbor->index(face);
+            p = TriangulationUtils::quadrilateralCentroid(
+                face->vertex((i + 1) % 3)->point(), face->vertex((i + 2) % 3)->point(),
+                neighbor->vertex((j + 1) % 3)->point(), neighbor->vertex((j + 2) % 3)->point());
+            return true;
+        }
+        return false;
+    }
+
+    static inline bool point(const FlatMesh& mesh, int face, Point& p) {
+        for (int i = 0; i < 3; ++i) {
+            int neighbor = mesh.neighbor(face, i);
+            if (neighbor == -1 || !mesh.isObtuse(neighbor)) continue;
+
+            int j = mesh.indexOf(neighbor, face);
+            p = TriangulationUtils::quadrilateralCentroid(
+                mesh.point(mesh.vertex(face, (i + 1) % 3)), mesh.point(mesh.vertex(face, (i + 2) % 3)),
+                mesh.point(mesh.vertex(neighbor, (j + 1) % 3)), mesh.point(mesh.vertex(neighbor, (j + 2) % 3)));
+            return true;
+        }
+        return false;
+    }
+};
+
+struct CentroidPoint {
+    static constexpr int ID = 4;
+
+    static inline bool point(const CDT& cdt, Face_handle face, Point& p) {
+        p = TriangulationUtils::computeCentroid(face->vertex(0)->point(), face->vertex(1)->point(), face->vertex(2)->point());
+        return true;
+    }
+
+    static inline bool point(const FlatMesh& mesh, int face, Point& p) {
+        p = TriangulationUtils::computeCentroid(mesh.point(mesh.vertex(face, 0)), mesh.point(mesh.vertex(face, 1)), mesh.point(mesh.vertex(face, 2)));
+        return true;
+    }
+};
+
+struct CircumcenterPoint {
+    static constexpr int ID = 5;
+
+    static inline bool point(const CDT& cdt, Face_handle face, Point& p) {
+        p = CGAL::circumcenter(face->vertex(0)->point(), face->vertex(1)->point(), face->vertex(2)->point());
+        return TriangulationUtils::is_point_inside_convex_hull(cdt, p);
+    }
+
+    // Rejected by FlatMesh::insertPoint if it lies outside the hull
+    static inline bool point(const FlatMesh& mesh, int face, Point& p) {
+        p = CGAL::circumcenter(mesh.point(mesh.vertex(face, 0)), mesh.point(mesh.vertex(face, 1)), mesh.point(mesh.vertex(face, 2)));
+        return true;
+    }
+};
+
+// Compile-time list of methods, iterated with static dispatch and without allocations
+template <class... Methods>
+struct MethodList {
+    static constexpr int size = sizeof...(Methods);
+
+    // f(Method()) for every method in order
+    template <class F>
+    static inline void forEach(F&& f) {
+        (f(Methods()), ...);
+    }
+
+    // f(Method()) for the method at position index, false if there is none
+    template <class F>
+    static inline bool visit(int index, F&& f) {
+        int position = 0;
+        return ((position++ == index ? (f(Methods()), true) : false) || ...);
+    }
+};
+
+// Specialised builds choose their methods with -DOPT_TRIANGULATION_METHODS="ProjectionPoint,MidpointPoint"
+#ifndef OPT_TRIANGULATION_METHODS
+#define OPT_TRIANGULATION_METHODS ProjectionPoint, MidpointPoint, QuadrilateralCentroidPoint, CentroidPoint, CircumcenterPoint
+#endif
+
+typedef MethodList<OPT_TRIANGULATION_METHODS> SteinerMethods;
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "triangulation.hpp"
+#include <map>
+
+// Splits the faces of a triangulation into tiles by recursive median cuts of their centroids or into clusters of obtuse faces.
+// Tile borders run along edges of the triangulation and are constrained in the tile triangulation,
+// so the tiles can be optimized independently and their Steiner points inserted back afterwards.
+class TileDecomposition {
+public:
+    struct Tile {
+        std::vector<Face_handle> faces;
+        int obtuseCount = 0;
+    };
+
+    // Tiles of at most maxFaces faces, tileOf maps every finite face to the index of its tile
+    static std::vector<Tile> partition(const CDT& cdt, int maxFaces, std::map<Face_handle, int>& tileOf);
+
+    // Connected clusters of obtuse faces, each with the faces up to halo rings around it. Clusters that overlap or
+    // touch are merged, larger ones than maxFaces are cut; faces far from any obtuse face are in no tile.
+    static std::vector<Tile> clusters(const CDT& cdt, int halo, int maxFaces, std::map<Face_handle, int>& tileOf);
+
+    // Triangulation of the vertices of tile with its border and the constrained edges inside it
+    static CDT extractTile(const CDT& cdt, const std::vector<Tile>& tiles, int tile, const std::map<Face_handle, int>& tileOf);
+
+    // True if p lies in the interior or on an edge of a face of tile, the tile triangulation also covers its convex hull
+    static bool owns(const CDT& cdt, int tile, const std::map<Face_handle, int>& tileOf, const Point& p);
+
+private:
+    // Append the tiles of recursive median cuts of faces, at most maxFaces each
+    static void split(const std::vector<Face_handle>& faces, int maxFaces, std::vector<Tile>& tiles, std::map<Face_handle, int>& tileOf);
+
+    static int tileIndex(const CDT& cdt, const std::map<Face_handle, int>& tileOf, Face_handle face);
+};
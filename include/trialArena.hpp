@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Monotonic memory for the triangulation copies of a single trial move.
+// Nothing is freed individually, reset() rewinds the arena in O(1) and keeps its chunks.
+class TrialArena {
+public:
+    explicit TrialArena(std::size_t chunkSize = 1 << 20);
+
+    TrialArena(const TrialArena&) = delete;
+    TrialArena& operator=(const TrialArena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    void reset();
+
+    std::size_t capacity() const;
+
+    // Arena that allocations of the calling thread are served from, nullptr for the heap
+    static TrialArena*& current();
+
+    // Arena owned by the calling thread
+    static TrialArena& local();
+
+private:
+    std::size_t chunkSize;
+    std::vector<std::unique_ptr<char[]>> chunks;
+    std::vector<std::size_t> sizes;
+    std::size_t chunk;
+    std::size_t offset;
+};
+
+// Serves the allocations of the calling thread from arena (nullptr: from the heap) while alive
+class ArenaScope {
+public:
+    explicit ArenaScope(TrialArena* arena) : previous(TrialArena::current()) { TrialArena::current() = arena; }
+    ~ArenaScope() { TrialArena::current() = previous; }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    TrialArena* previous;
+};
+
+// Allocator of the triangulation vertices and faces (see ArenaAllocated). Every block starts with the arena
+// it came from so that memory allocated on the heap is still freed when it is released inside a trial.
+template <class T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind { typedef ArenaAllocator<U> other; };
+
+    ArenaAllocator() noexcept {}
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        std::size_t bytes = HEADER + n * sizeof(T);
+        TrialArena* arena = TrialArena::current();
+        char* block = arena != nullptr
+            ? static_cast<char*>(arena->allocate(bytes, alignof(std::max_align_t)))
+            : static_cast<char*>(::operator new(bytes));
+        *reinterpret_cast<TrialArena**>(block) = arena;
+        return reinterpret_cast<T*>(block + HEADER);
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        char* block = reinterpret_cast<char*>(p) - HEADER;
+        if (*reinterpret_cast<TrialArena**>(block) == nullptr) {
+            ::operator delete(block);
+        }
+    }
+
+    template <class U>
+    bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+    template <class U>
+    bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+
+private:
+    static constexpr std::size_t HEADER = alignof(std::max_align_t) > sizeof(TrialArena*)
+        ? alignof(std::max_align_t) : sizeof(TrialArena*);
+};
+
+// Vertex or face base of a triangulation data structure whose vertices or faces are allocated with
+// ArenaAllocator. The data structure keeps them in containers with the default allocator, so the
+// allocator is chosen through std::allocator below for these types only.
+template <class Base>
+class ArenaAllocated : public Base {
+public:
+    template <class Tds>
+    struct Rebind_TDS {
+        typedef ArenaAllocated<typename Base::template Rebind_TDS<Tds>::Other> Other;
+    };
+
+    using Base::Base;
+};
+
+namespace std {
+
+template <class Base>
+class allocator<ArenaAllocated<Base>> : public ArenaAllocator<ArenaAllocated<Base>> {
+public:
+    typedef ArenaAllocated<Base> value_type;
+    typedef value_type* pointer;
+    typedef const value_type* const_pointer;
+    typedef value_type& reference;
+    typedef const value_type& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type is_always_equal;
+
+    template <class U>
+    struct rebind { typedef allocator<U> other; };
+
+    allocator() noexcept {}
+    allocator(const allocator&) noexcept {}
+    template <class U>
+    allocator(const allocator<U>&) noexcept {}
+
+    template <class U, class... Args>
+    void construct(U* p, Args&&... args) { ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+    template <class U>
+    void destroy(U* p) { p->~U(); }
+
+    size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(value_type); }
+};
+
+}
@@ -1,6 +1,11 @@
 #pragma once
+
+#include "trialArena.hpp"
 #include <CGAL/Exact_predicates_exact_constructions_kernel.h>
 #include <CGAL/Constrained_Delaunay_triangulation_2.h>
+#include <CGAL/Constrained_triangulation_face_base_2.h>
+#include <CGAL/Triangulation_data_structure_2.h>
+#include <CGAL/Triangulation_vertex_base_2.h>
 #include <CGAL/Line_2.h>
 #include <vector>
 #include <string>
@@ -17,7 +22,19 @@ typedef CGAL::Exact_predicates_exact_constructions_kernel Kernel;
 typedef Kernel::FT FT;
 typedef CGAL::Point_2<Kernel> Point;
 typedef CGAL::Segment_2<Kernel> Segment;
-typedef CGAL::Constrained_Delaunay_triangulation_2<Kernel> CDT;
+// Triangulation over a chosen data structure
+template <class Tds = CGAL::Default>
+using BasicCDT = CGAL::Constrained_Delaunay_triangulation_2<Kernel, Tds>;
+#ifdef OPT_TRIANGULATION_ARENA
+// The default data structure with faces and vertices from the trial arena of the thread, if one is active.
+// Only the data structure is covered: points and the lazy exact numbers of the kernel stay on the heap.
+typedef CGAL::Triangulation_data_structure_2<
+    ArenaAllocated<CGAL::Triangulation_vertex_base_2<Kernel>>,
+    ArenaAllocated<CGAL::Constrained_triangulation_face_base_2<Kernel>>> TrialTds;
+typedef BasicCDT<TrialTds> CDT;
+#else
+typedef BasicCDT<> CDT;
+#endif
 typedef CDT::Vertex_handle Vertex_handle;
 typedef CDT::Face_handle Face_handle;
 typedef CDT::Edge Edge;
@@ -52,6 +69,15 @@ struct InputData {
     double kappa;
     int L;
     bool delaunay;
+    double time_limit;     // 0 selects the default budget of the engine
+    unsigned int seed;
+    bool prune;            // remove redundant Steiner points after the optimization
+    long snap_denominator; // bound on the denominators of Steiner coordinates, 0 keeps them exact
+    bool snap_grid;        // snap to multiples of 1 / snap_denominator instead of the nearest rational
+    int materialize_every; // accepted steps between flattening the lazy exact points, 0 never
+    double target_ratio;   // fraction of the initial obtuse count whose time to reach is reported, negative for none
+    bool stats;            // add the run statistics to the output
+    int stats_samples;     // size of the time series in the statistics
 };
 
 struct OutputData {
@@ -64,4 +90,5 @@ struct OutputData {
     std::string method;
     nlohmann::json parameters;
     bool randomization_used;
+    nlohmann::json stats;  // written only when requested, see InputData::stats
 };
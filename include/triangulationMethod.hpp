@@ -2,29 +2,38 @@
 
 #include "triangulation.hpp"
 
+// Result of one ant, replayed on the triangulation only if it wins the cycle
+struct AntMove {
+    Vertex_handle face[3];   // vertices of the target face
+    int method = -1;         // index of the method in the colony, -1 for no move
+    Point point;             // Steiner point to insert
+    int relocated = -1;      // index of the Steiner point moved to point instead, -1 for an insertion
+    double energyDelta = 0;
+};
+
 class TriangulationMethod {
 protected:
 // State management for ant colonies algorithm
     double pheromones;
     double pheromonesDelta;
     double energyDelta;
-    CDT antColonyCdt;
-    std::vector<Point> antColonySteinerPoints;
+    AntMove antColonyMove;
 public:
     // Getters
     inline double getPheromones() const { return pheromones; }
     inline double getPheromonesDelta() const { return pheromonesDelta; }
     inline double getEnergyDelta() const { return energyDelta; }
-    inline const CDT& getAntColonyCdt() const { return antColonyCdt; }
-    inline const std::vector<Point>& getAntColonySteinerPoints() const { return antColonySteinerPoints; }
+    inline const AntMove& getAntColonyMove() const { return antColonyMove; }
 
     // Setters
     inline void setPheromones(double value) { pheromones = value; }
     inline void setPheromonesDelta(double value) { pheromonesDelta = value; }
     inline void setEnergyDelta(double value) { energyDelta = value; }
-    inline void setAntColonyCdt(const CDT& cdt) { antColonyCdt = cdt; }
-    inline void setAntColonySteinerPoints(const std::vector<Point>& points) { antColonySteinerPoints = points; }
+    inline void setAntColonyMove(const AntMove& move) { antColonyMove = move; }
+
+    // Steiner point the method would insert for face, false if it has none
+    virtual bool steinerPoint(const CDT& cdt, Face_handle face, Point& point) = 0;
 
     virtual void execute(CDT& cdt, Face_handle face, std::vector<Point>& steiner_points) = 0;
     virtual double antColoniesHeuristic(CDT& cdt, Face_handle face, FT radiusToHeightRatio) = 0;
-};
\ No newline at end of file
+};
@@ -18,6 +18,19 @@ public:
     
     static int findObtuseAngle(const Point& p1, const Point& p2, const Point& p3);
 
+    // Projection of the obtuse vertex onto the opposite edge, false if the triangle is not obtuse
+    static bool obtuseProjection(const Point& p1, const Point& p2, const Point& p3, Point& projection);
+
+    static Point longestEdgeMidpoint(const Point& p1, const Point& p2, const Point& p3);
+
+    // Nearest rational with denominator at most maxDenominator, or nearest multiple of 1 / maxDenominator if grid
+    static FT snapCoordinate(const FT& value, long maxDenominator, bool grid);
+
+    static Point snapPoint(const Point& p, long maxDenominator, bool grid);
+
+    // Copy of p holding only its exact value, without the lazy construction history
+    static Point exactPoint(const Point& p);
+
     static bool is_point_inside_convex_hull(const CDT& cdt, const Point& point);
     
     static FT computeCircumradius(const Triangle& triangle);
@@ -28,6 +41,8 @@ public:
 
     static Face_handle getRandomObtuseTriangle(const CDT& cdt);
 
+    static Face_handle getRandomObtuseTriangle(const CDT& cdt, std::mt19937& gen);
+
     static bool isConvexBoundary(const std::vector<Point>& boundary);
 
     static bool areConstraintsClosed(const std::vector<std::pair<Point, Point>>& constraints);
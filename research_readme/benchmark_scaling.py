@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+# Runs every engine on the synthetic instances of generate_instances.py and records how they scale with n
+#
+# Usage (from the build directory, like run_tests.sh):
+#   python3 ../research_readme/benchmark_scaling.py [--engines ls,sa,ant,beam,tiles] [--time-limit 60] [--plot]
+#
+# Each run sets "stats": true in the parameters and reads the stats block of the output: the time per
+# iteration and the time until the obtuse count first dropped to --target times its initial value.
+# Rows are appended to scaling_results.csv, --plot draws scaling_<family>.png (needs matplotlib).
+
+import argparse
+import csv
+import glob
+import json
+import os
+import subprocess
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DATA_DIR = os.path.join(HERE, "..", "data", "synthetic")
+RESULTS = os.path.join(HERE, "scaling_results.csv")
+
+FIELDS = ["family", "n", "engine", "seed", "initial_obtuse", "obtuse", "steiner", "iterations", "elapsed",
+          "time_per_iteration", "target_obtuse", "time_to_target", "peak_rss_kb"]
+
+
+def family_and_size(uid):
+    family, n, _ = uid.rsplit("_", 2)
+    return family, int(n)
+
+
+def run(exe, instance, engine, time_limit, target, seed, workdir):
+    instance = dict(instance)
+    instance["method"] = engine
+    instance["parameters"] = {"time_limit": time_limit, "seed": seed, "target_ratio": target, "stats": True}
+    input_file = os.path.join(workdir, "input.json")
+    output_file = os.path.join(workdir, "output.json")
+    with open(input_file, "w") as f:
+        json.dump(instance, f)
+    if os.path.exists(output_file):
+        os.remove(output_file)
+
+    # Engines stop on their own budget, the timeout only catches a run that hangs
+    completed = subprocess.run([exe, "-i", input_file, "-o", output_file], stdout=subprocess.DEVNULL,
+                               stderr=subprocess.PIPE, timeout=10 * time_limit + 600)
+    if completed.returncode != 0 or not os.path.exists(output_file):
+        print("  failed: %s" % completed.stderr.decode().strip())
+        return None
+    with open(output_file) as f:
+        return json.load(f).get("stats")
+
+
+def benchmark(args):
+    instances = sorted(glob.glob(os.path.join(args.data, "*.instance.json")))
+    if not instances:
+        raise SystemExit("No instances in %s, run generate_instances.py first" % args.data)
+
+    new_file = not os.path.exists(args.output)
+    with open(args.output, "a", newline="") as out, tempfile.TemporaryDirectory() as workdir:
+        writer = csv.DictWriter(out, fieldnames=FIELDS)
+        if new_file:
+            writer.writeheader()
+        for path in instances:
+            with open(path) as f:
+                instance = json.load(f)
+            family, n = family_and_size(instance["instance_uid"])
+            for engine in args.engines.split(","):
+                print("Processing: %s with %s" % (instance["instance_uid"], engine))
+                stats = run(args.exe, instance, engine, args.time_limit, args.target, args.seed, workdir)
+                if stats is None:
+                    continue
+                row = {"family": family, "n": n, "engine": engine, "seed": args.seed}
+                row.update({field: stats[field] for field in FIELDS if field in stats})
+                writer.writerow(row)
+                out.flush()
+
+
+def plot(args):
+    # Imported here so that the benchmark itself runs without matplotlib
+    try:
+        import matplotlib
+        matplotlib.use("Agg")
+        import matplotlib.pyplot as plt
+    except ImportError:
+        raise SystemExit("--plot needs matplotlib (pip install matplotlib)")
+
+    rows = {}
+    with open(args.output) as f:
+        for row in csv.DictReader(f):
+            rows.setdefault(row["family"], []).append(row)
+
+    for family, family_rows in sorted(rows.items()):
+        figure, (per_iteration, to_target) = plt.subplots(1, 2, figsize=(12, 5))
+        for engine in sorted(set(row["engine"] for row in family_rows)):
+            runs = sorted((int(row["n"]), float(row["time_per_iteration"]), float(row["time_to_target"]))
+                          for row in family_rows if row["engine"] == engine)
+            per_iteration.plot([r[0] for r in runs if r[1] > 0], [r[1] for r in runs if r[1] > 0], marker="o", label=engine)
+            # Runs that never reached the target are left out
+            to_target.plot([r[0] for r in runs if r[2] >= 0], [r[2] for r in runs if r[2] >= 0], marker="o", label=engine)
+
+        per_iteration.set_title("%s: time per iteration" % family)
+        per_iteration.set_ylabel("seconds")
+        to_target.set_title("%s: time to %g of the initial obtuse count" % (family, args.target))
+        to_target.set_ylabel("seconds")
+        for axes in (per_iteration, to_target):
+            axes.set_xscale("log")
+            axes.set_yscale("log")
+            axes.set_xlabel("n")
+            axes.legend()
+        figure.tight_layout()
+        path = os.path.join(os.path.dirname(args.output), "scaling_%s.png" % family)
+        figure.savefig(path)
+        print("Wrote %s" % path)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Scaling benchmark of the optimization engines")
+    parser.add_argument("--exe", default="./opt_triangulation")
+    parser.add_argument("--data", default=DATA_DIR)
+    parser.add_argument("--engines", default="ls,sa,ant,beam,tiles")
+    parser.add_argument("--time-limit", type=float, default=60.0)
+    parser.add_argument("--target", type=float, default=0.5)
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--output", default=RESULTS)
+    parser.add_argument("--plot", action="store_true")
+    parser.add_argument("--plot-only", action="store_true", help="only draw the plots of an existing csv")
+    args = parser.parse_args()
+
+    if not args.plot_only:
+        benchmark(args)
+    if args.plot or args.plot_only:
+        plot(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,6 +1,8 @@
 #!/bin/bash
 
 EXE="./opt_triangulation"  # Path to your executable
+VALIDATE="./opt_triangulation_validate"  # Independent check of the solutions
+CACHE_DIR="../.cache"  # Results of unchanged instances, parameters and builds are reused
 INPUT_DIR="../data"  # Directory containing input JSON files
 OUTPUT_DIR="../results"  # Directory to store output files
 
@@ -16,7 +18,10 @@ for input_file in $(ls "$INPUT_DIR"/simple-polygon-exterior-*.json 2>/dev/null |
     output_file="$OUTPUT_DIR/${base_name}.output.json"
     
     echo "Processing: $input_file -> $output_file"
-    "$EXE" -i "$input_file" -o "$output_file"
+    "$EXE" -i "$input_file" -o "$output_file" --cache "$CACHE_DIR"
 
     printf "\n"
 done
+
+# Every solution is checked against its instance, the script fails if one is invalid
+"$VALIDATE" --dir "$INPUT_DIR" "$OUTPUT_DIR"
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+# Fits the algorithm selector from the research results and writes include/selectorTable.hpp
+#
+# Usage (from research_readme/): python3 fit_selector.py
+#
+# Every row of the *_results.csv files becomes a sample: the features of the instance
+# (read from ../data/<ID>.instance.json) and the engine with the lowest energy
+# a * obtuse + b * steiner, with the default a, b of JsonUtils::parseInputJson.
+#
+# The ant colony runs are scored as well, but they never have the lowest energy (ties go to the
+# earlier engine of ENGINES), so the table has no "ant" samples and the selector never picks it.
+
+import csv
+import glob
+import json
+import os
+
+A = 5.0
+B = 1.0
+
+ENGINES = [
+    ("ls", "Local Search obtuse triangles", "Local Search Steiner points"),
+    ("sa", "Simulated Annealing obtuse triangles", "Simulated Annealing Steiner points"),
+    ("ant", "Ant Colony obtuse triangles", "Ant Colony Steiner points"),
+]
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+DATA_DIR = os.path.join(HERE, "..", "data")
+OUTPUT = os.path.join(HERE, "..", "include", "selectorTable.hpp")
+
+
+def cross(o, a, b):
+    return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0])
+
+
+def is_convex(boundary):
+    # Same answer as Polygon_2::is_convex for the simple boundaries of the corpus
+    n = len(boundary)
+    sign = 0
+    for i in range(n):
+        turn = cross(boundary[i], boundary[(i + 1) % n], boundary[(i + 2) % n])
+        if turn == 0:
+            continue
+        if sign == 0:
+            sign = 1 if turn > 0 else -1
+        elif (turn > 0) != (sign > 0):
+            return False
+    return True
+
+
+def is_axis_parallel(boundary):
+    n = len(boundary)
+    for i in range(n):
+        p1, p2 = boundary[i], boundary[(i + 1) % n]
+        if p1[0] != p2[0] and p1[1] != p2[1]:
+            return False
+    return True
+
+
+def are_constraints_closed(constraints):
+    degree = {}
+    for a, b in constraints:
+        degree[a] = degree.get(a, 0) + 1
+        degree[b] = degree.get(b, 0) + 1
+    return all(d == 2 for d in degree.values())
+
+
+def features(instance_id, initial_obtuse):
+    with open(os.path.join(DATA_DIR, instance_id + ".instance.json")) as f:
+        instance = json.load(f)
+    points = list(zip(instance["points_x"], instance["points_y"]))
+    boundary = [points[i] for i in instance["region_boundary"]]
+    constraints = instance["additional_constraints"]
+    n = instance["num_points"]
+    return {
+        "num_points": n,
+        "convex": is_convex(boundary),
+        "axis_parallel": is_axis_parallel(boundary),
+        "num_constraints": len(constraints),
+        "closed": are_constraints_closed(constraints),
+        "obtuse_ratio": initial_obtuse / n,
+    }
+
+
+def best_engine(row):
+    def energy(engine):
+        _, obtuse, steiner = engine
+        return A * float(row[obtuse]) + B * float(row[steiner])
+    return min(ENGINES, key=energy)[0]
+
+
+def main():
+    samples = []
+    for path in sorted(glob.glob(os.path.join(HERE, "*_results.csv"))):
+        if path.endswith("_test_test.csv"):
+            continue
+        with open(path) as f:
+            for row in csv.DictReader(f):
+                instance_id = row["ID"].strip()
+                if not os.path.exists(os.path.join(DATA_DIR, instance_id + ".instance.json")):
+                    continue
+                sample = features(instance_id, float(row["Initial obtuse triangles"]))
+                sample["id"] = instance_id
+                sample["engine"] = best_engine(row)
+                samples.append(sample)
+
+    with open(OUTPUT, "w") as out:
+        out.write("#pragma once\n\n")
+        out.write("// Generated by research_readme/fit_selector.py from research_readme/*_results.csv, do not edit\n\n")
+        out.write('#include "algorithmSelector.hpp"\n\n')
+        out.write("static const SelectorSample SELECTOR_TABLE[] = {\n")
+        for s in samples:
+            out.write('    {{ {}, {}, {}, {}, {}, {:.6f}, "{}" }}, // {}\n'.format(
+                s["num_points"],
+                "true" if s["convex"] else "false",
+                "true" if s["axis_parallel"] else "false",
+                s["num_constraints"],
+                "true" if s["closed"] else "false",
+                s["obtuse_ratio"],
+                s["engine"],
+                s["id"]))
+        out.write("};\n")
+
+    counts = {}
+    for s in samples:
+        counts[s["engine"]] = counts.get(s["engine"], 0) + 1
+    print("Wrote {} samples to {} ({})".format(len(samples), OUTPUT, counts))
+
+
+if __name__ == "__main__":
+    main()
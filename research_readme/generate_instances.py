@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+# Generates synthetic instances in the schema of data/ for the scaling benchmark
+#
+# Usage (from research_readme/): python3 generate_instances.py [--sizes 1000,10000] [--families ortho,point-set] [--seed 1]
+#
+# Families, as in the categories of the research:
+#   point-set                random points, the boundary is their convex hull
+#   point-set-open           points in a square with disjoint open constraint segments
+#   point-set-closed         points in a square with disjoint constrained triangles
+#   ortho                    axis-parallel (histogram) polygon, every point on the boundary
+#   simple-polygon           star-shaped polygon, every point on the boundary
+#   simple-polygon-exterior  star-shaped polygon with a fifth of the points on the boundary
+#
+# Coordinates are integers in [0, SIZE] and the boundary is counter-clockwise. The generated files are
+# written to ../data/synthetic/<family>_<n>_<hash>.instance.json
+
+import argparse
+import bisect
+import hashlib
+import json
+import math
+import os
+import random
+
+SIZE = 1000000
+FAMILIES = ["point-set", "point-set-open", "point-set-closed", "ortho", "simple-polygon", "simple-polygon-exterior"]
+SIZES = [1000, 2000, 5000, 10000, 20000, 50000, 100000]
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+OUTPUT_DIR = os.path.join(HERE, "..", "data", "synthetic")
+
+
+def cross(o, a, b):
+    return (a[0] - o[0]) * (b[1] - o[1]) - (a[1] - o[1]) * (b[0] - o[0])
+
+
+def convex_hull(points):
+    # Andrew's monotone chain, counter-clockwise indices without collinear points
+    order = sorted(range(len(points)), key=lambda i: points[i])
+    lower, upper = [], []
+    for i in order:
+        while len(lower) >= 2 and cross(points[lower[-2]], points[lower[-1]], points[i]) <= 0:
+            lower.pop()
+        lower.append(i)
+    for i in reversed(order):
+        while len(upper) >= 2 and cross(points[upper[-2]], points[upper[-1]], points[i]) <= 0:
+            upper.pop()
+        upper.append(i)
+    return lower[:-1] + upper[:-1]
+
+
+def random_points(rng, count, taken, x0, y0, x1, y1):
+    # Distinct points strictly inside the box (x0, y0) - (x1, y1)
+    points = []
+    while len(points) < count:
+        p = (rng.randint(x0 + 1, x1 - 1), rng.randint(y0 + 1, y1 - 1))
+        if p not in taken:
+            taken.add(p)
+            points.append(p)
+    return points
+
+
+def point_set(rng, n):
+    points = random_points(rng, n, set(), 0, 0, SIZE, SIZE)
+    return points, convex_hull(points), []
+
+
+def constrained_point_set(rng, n, closed):
+    # The square is cut in cells, constrained cells hold only their own segment or triangle so
+    # constraints never cross each other or pass through another point
+    grid = max(2, math.ceil(math.sqrt(n)))
+    cell = SIZE // grid
+    corners = [(0, 0), (SIZE, 0), (SIZE, SIZE), (0, SIZE)]
+    points = list(corners)
+    taken = set(corners)
+    constraints = []
+
+    per_cell = 3 if closed else 2
+    cells = rng.sample(range(grid * grid), min(grid * grid - 1, max(1, n // (5 * per_cell))))
+    for c in cells:
+        x0, y0 = (c % grid) * cell, (c // grid) * cell
+        while True:
+            shape = random_points(rng, per_cell, set(), x0, y0, x0 + cell, y0 + cell)
+            if any(p in taken for p in shape):
+                continue
+            if closed and cross(*shape) == 0:
+                continue
+            break
+        start = len(points)
+        for p in shape:
+            taken.add(p)
+            points.append(p)
+        if closed:
+            constraints += [[start, start + 1], [start + 1, start + 2], [start + 2, start]]
+        else:
+            constraints.append([start, start + 1])
+
+    blocked = set(cells)
+    free = [c for c in range(grid * grid) if c not in blocked]
+    while len(points) < n:
+        c = rng.choice(free)
+        x0, y0 = (c % grid) * cell, (c // grid) * cell
+        points += random_points(rng, 1, taken, x0, y0, x0 + cell, y0 + cell)
+    return points, [0, 1, 2, 3], constraints
+
+
+def ortho(rng, n):
+    # Histogram polygon: a bottom edge and columns of distinct consecutive heights
+    columns = max(1, (n - 2) // 2)
+    xs = sorted(rng.sample(range(0, SIZE + 1), columns + 1))
+    heights = []
+    for _ in range(columns):
+        h = rng.randint(SIZE // 10, SIZE)
+        while heights and h == heights[-1]:
+            h = rng.randint(SIZE // 10, SIZE)
+        heights.append(h)
+
+    points = [(xs[0], 0), (xs[-1], 0)]
+    for i in range(columns, 0, -1):
+        points.append((xs[i], heights[i - 1]))
+        points.append((xs[i - 1], heights[i - 1]))
+    boundary = list(range(len(points)))
+
+    # An odd n gets one point inside the lowest part of the first column
+    if len(points) < n:
+        points.append(((xs[0] + xs[1]) // 2, SIZE // 20))
+    return points, boundary, []
+
+
+def star_polygon(rng, m):
+    # Stratified angles around the center keep the vertices in angular order after rounding
+    center = (SIZE // 2, SIZE // 2)
+    radius = 0.45 * SIZE
+    while True:
+        points = []
+        for i in range(m):
+            angle = 2 * math.pi * (i + 0.5 * rng.random()) / m
+            r = radius * (0.5 + 0.5 * rng.random())
+            points.append((center[0] + round(r * math.cos(angle)), center[1] + round(r * math.sin(angle))))
+        # Strictly counter-clockwise around the center with gaps below pi: the polygon is simple
+        if all(cross(center, points[i], points[(i + 1) % m]) > 0 for i in range(m)) and len(set(points)) == m:
+            return center, points
+
+
+def simple_polygon(rng, n):
+    _, points = star_polygon(rng, n)
+    return points, list(range(n)), []
+
+
+def simple_polygon_exterior(rng, n):
+    m = max(3, n // 5)
+    center, boundary = star_polygon(rng, m)
+    angles = [math.atan2(p[1] - center[1], p[0] - center[0]) % (2 * math.pi) for p in boundary]
+    points = list(boundary)
+    taken = set(points)
+    while len(points) < n:
+        p = (rng.randint(0, SIZE), rng.randint(0, SIZE))
+        if p in taken or p == center:
+            continue
+        # The wedge of the fan triangle (center, v_i, v_i+1) that contains p, checked exactly
+        angle = math.atan2(p[1] - center[1], p[0] - center[0]) % (2 * math.pi)
+        i = (bisect.bisect_right(angles, angle) - 1) % m
+        a, b = boundary[i], boundary[(i + 1) % m]
+        if cross(center, a, p) >= 0 and cross(center, b, p) <= 0 and cross(a, b, p) > 0:
+            taken.add(p)
+            points.append(p)
+    return points, list(range(m)), []
+
+
+GENERATORS = {
+    "point-set": point_set,
+    "point-set-open": lambda rng, n: constrained_point_set(rng, n, False),
+    "point-set-closed": lambda rng, n: constrained_point_set(rng, n, True),
+    "ortho": ortho,
+    "simple-polygon": simple_polygon,
+    "simple-polygon-exterior": simple_polygon_exterior,
+}
+
+
+def generate(family, n, seed):
+    rng = random.Random("%s/%d/%d" % (family, n, seed))
+    points, boundary, constraints = GENERATORS[family](rng, n)
+    content = {
+        "points_x": [p[0] for p in points],
+        "points_y": [p[1] for p in points],
+        "region_boundary": boundary,
+        "num_constraints": len(constraints),
+        "additional_constraints": constraints,
+    }
+    digest = hashlib.sha1(json.dumps(content).encode()).hexdigest()[:8]
+    instance = {"instance_uid": "%s_%d_%s" % (family, len(points), digest), "num_points": len(points)}
+    instance.update(content)
+    return instance
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate synthetic instances for the scaling benchmark")
+    parser.add_argument("--families", default=",".join(FAMILIES))
+    parser.add_argument("--sizes", default=",".join(str(n) for n in SIZES))
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--output", default=OUTPUT_DIR)
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    for family in args.families.split(","):
+        if family not in GENERATORS:
+            parser.error("unknown family " + family)
+        for n in [int(size) for size in args.sizes.split(",")]:
+            instance = generate(family, n, args.seed)
+            path = os.path.join(args.output, instance["instance_uid"] + ".instance.json")
+            with open(path, "w") as f:
+                json.dump(instance, f)
+            print("Wrote %s" % path)
+
+
+if __name__ == "__main__":
+    main()
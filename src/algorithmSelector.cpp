@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include "algorithmSelector.hpp"
+#include "selectorTable.hpp"
+#include "triangulationUtils.hpp"
+
+// Number of nearest samples that vote
+#define SELECTOR_NEIGHBOURS 5
+// Instances above this many points are decomposed into tiles
+#define TILING_THRESHOLD 2000
+// The ortho construction classifies a grid of up to n^2 cells, above this many points it is not worth it
+#define ORTHO_THRESHOLD 500
+
+SelectorFeatures AlgorithmSelector::extractFeatures(const CDT& cdt, const std::vector<Point>& boundary, const std::vector<std::pair<Point, Point>>& constraints) {
+    SelectorFeatures features;
+    features.num_points = cdt.number_of_vertices();
+    features.convex = TriangulationUtils::isConvexBoundary(boundary);
+    features.axis_parallel = TriangulationUtils::isAxisParallel(boundary);
+    features.num_constraints = constraints.size();
+    features.closed_constraints = TriangulationUtils::areConstraintsClosed(constraints);
+    features.obtuse_ratio = features.num_points > 0
+        ? static_cast<double>(TriangulationUtils::countObtuseTriangles(cdt)) / features.num_points
+        : 0.0;
+    return features;
+}
+
+double AlgorithmSelector::distance(const SelectorFeatures& features, const SelectorSample& sample) {
+    // Doubling the size counts as much as half a category mismatch
+    double size = std::log2(std::max(features.num_points, 1)) - std::log2(std::max(sample.num_points, 1));
+    double density = static_cast<double>(features.num_constraints) / std::max(features.num_points, 1)
+                   - static_cast<double>(sample.num_constraints) / std::max(sample.num_points, 1);
+
+    double d = 0.5 * std::abs(size);
+    d += features.convex != sample.convex ? 1.0 : 0.0;
+    d += features.axis_parallel != sample.axis_parallel ? 1.0 : 0.0;
+    d += features.closed_constraints != sample.closed_constraints ? 0.5 : 0.0;
+    d += std::abs(density);
+    d += std::abs(features.obtuse_ratio - sample.obtuse_ratio);
+    return d;
+}
+
+std::string AlgorithmSelector::select(const SelectorFeatures& features) {
+    // The corpus has no instances of this size, the global engines do not finish them in the budget
+    if (features.num_points > TILING_THRESHOLD) return "tiles";
+
+    // Axis-parallel domains have a constructive solution, the search only finishes it
+    if (features.axis_parallel && features.num_points <= ORTHO_THRESHOLD) return "ortho";
+
+    std::vector<std::pair<double, const SelectorSample*>> neighbours;
+    for (const auto& sample : SELECTOR_TABLE) {
+        neighbours.emplace_back(distance(features, sample), &sample);
+    }
+
+    size_t k = std::min<size_t>(SELECTOR_NEIGHBOURS, neighbours.size());
+    std::partial_sort(neighbours.begin(), neighbours.begin() + k, neighbours.end(),
+        [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    std::map<std::string, double> votes;
+    for (size_t i = 0; i < k; ++i) {
+        votes[neighbours[i].second->engine] += 1.0 / (neighbours[i].first + 0.05);
+    }
+
+    std::string best = "ls";
+    double best_votes = 0.0;
+    for (const auto& [engine, vote] : votes) {
+        if (vote > best_votes) {
+            best = engine;
+            best_votes = vote;
+        }
+    }
+    return best;
+}
+
+std::string AlgorithmSelector::select(const CDT& cdt, const std::vector<Point>& boundary, const std::vector<std::pair<Point, Point>>& constraints) {
+    return select(extractFeatures(cdt, boundary, constraints));
+}
@@ -5,6 +5,11 @@
 #include <cstdlib>
 #include <ctime>
 #include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <queue>
 
 
 #include "triangulation.hpp"
@@ -16,124 +21,245 @@
 #include "centroidMethod.hpp"
 #include "oneCentroid.hpp"
 #include "projectionMethod.hpp"
+#include "steinerMethods.hpp"
+#include "algorithms.hpp"
+#include "flatMesh.hpp"
+#include "trialArena.hpp"
 
-// LOCAL SEARCH
+// Obtuse faces of a beam state that are expanded per step
+#define BEAM_FACES 16
 
-int find_best_method(CDT cdt, Face_handle face){
+// LOCAL SEARCH
 
-    std::vector<Point> dummy_points; // Temporary vector for Steiner points
-    int initial_obtuse_count = TriangulationUtils::countObtuseTriangles(cdt);
+// Obtuse count after inserting p, -1 if p cannot be inserted. The mesh is left unchanged.
+static int trial_obtuse_count(FlatMesh& mesh, const Point& p, int hint) {
+    // Try the insertion and undo it, only the touched faces are restored
+    mesh.beginTrial();
+    bool inserted = mesh.insertPoint(p, hint);
+    int obtuse_count = mesh.countObtuse();
+    mesh.rollback();
+    return inserted ? obtuse_count : -1;
+}
 
-    CDT starting_cdt = cdt;
-    CDT test_cdt;
+// Replace candidate by its snapped version if that does at least as well
+static void snap_candidate(FlatMesh& mesh, const SearchControl& control, int hint, Point& candidate, int& obtuse_count) {
+    Point snapped;
+    if (obtuse_count < 0 || !control.snap(candidate, snapped)) return;
+    int snapped_count = trial_obtuse_count(mesh, snapped, hint);
+    if (snapped_count >= 0 && snapped_count <= obtuse_count) {
+        candidate = snapped;
+        obtuse_count = snapped_count;
+    }
+}
 
+int find_best_method(FlatMesh& mesh, int face, Point& best_point, int& best_obtuse_count, const SearchControl& control) {
     int best_method = 6; // Default to 6 if none improves
-    int best_obtuse_count = initial_obtuse_count;
-
-    ProjectionMethod* method1;
-    method1 = new ProjectionMethod();
-    method1->insertProjection(cdt, face, dummy_points);
-    delete method1;
-    int projection_obtuse_count = TriangulationUtils::countObtuseTriangles(cdt);
-    cdt = starting_cdt;
-    if (projection_obtuse_count < best_obtuse_count) {
-        best_obtuse_count = projection_obtuse_count;
-        best_method = 1;
-    }
-
-    MidpointMethod* method2;
-    method2 = new MidpointMethod();
-    method2->insertMidpoint(cdt, face, dummy_points);
-    delete method2;
-    int midpoint_obtuse_count = TriangulationUtils::countObtuseTriangles(cdt);
-    cdt = starting_cdt;
-    if (midpoint_obtuse_count < best_obtuse_count) {
-        best_obtuse_count = midpoint_obtuse_count;
-        best_method = 2;
-    }
-
-    CentroidMethod* method3;
-    method3 = new CentroidMethod();
-    method3->insertCentroid(cdt, face, dummy_points);
-    delete method3;
-    int centroid_obtuse_count = TriangulationUtils::countObtuseTriangles(cdt);
-    cdt = starting_cdt;
-    if (centroid_obtuse_count < best_obtuse_count) {
-        best_obtuse_count = centroid_obtuse_count;
-        best_method = 3;
-    }
-
-    oneCentroidMethod* method4;
-    method4 = new oneCentroidMethod();
-    method4->insertoneCentroid(cdt, face, dummy_points);
-    delete method4;
-    int onecentroid_obtuse_count = TriangulationUtils::countObtuseTriangles(cdt);
-    cdt = starting_cdt;
-    if (onecentroid_obtuse_count < best_obtuse_count) {
-        best_obtuse_count = onecentroid_obtuse_count;
-        best_method = 4;
-    }
-
-    CircumCenterMethod* method5;
-    method5 = new CircumCenterMethod();
-    method5->insertCircumcenter(cdt, face, dummy_points);
-    delete method5;
-    int circumcenter_obtuse_count = TriangulationUtils::countObtuseTriangles(cdt);
-    cdt = starting_cdt;
-    if (circumcenter_obtuse_count < best_obtuse_count) {
-        best_obtuse_count = circumcenter_obtuse_count;
-        best_method = 5;
-    }
+    best_obtuse_count = mesh.countObtuse();
+
+    SteinerMethods::forEach([&](auto method) {
+        typedef decltype(method) Method;
+        Point candidate;
+        if (!Method::point(mesh, face, candidate)) return;
+
+        int obtuse_count = trial_obtuse_count(mesh, candidate, face);
+        snap_candidate(mesh, control, face, candidate, obtuse_count);
+        bool inserted = obtuse_count >= 0;
+
+        if (inserted && obtuse_count < best_obtuse_count) {
+            best_obtuse_count = obtuse_count;
+            best_method = Method::ID;
+            best_point = candidate;
+        }
+    });
 
     return best_method;
+}
+
+// Relocation moves
+
+SteinerIndex make_steiner_index(const std::vector<Point>& steinerPoints) {
+    SteinerIndex steinerIndex;
+    for (size_t i = 0; i < steinerPoints.size(); ++i) {
+        steinerIndex.emplace(steinerPoints[i], i);
+    }
+    return steinerIndex;
+}
+
+// True if p sees every edge of the counter-clockwise link polygon from the left
+static bool in_star_kernel(const std::vector<Point>& link, const Point& p) {
+    for (size_t j = 0; j < link.size(); ++j) {
+        if (CGAL::orientation(link[j], link[(j + 1) % link.size()], p) != CGAL::LEFT_TURN) return false;
+    }
+    return true;
+}
+
+// Centroid of the link, or halfway to it if the centroid is outside the kernel of the star
+static bool relocation_target(const std::vector<Point>& link, const Point& current, Point& target) {
+    FT x(0), y(0);
+    for (const auto& p : link) {
+        x += p.x();
+        y += p.y();
+    }
+    FT n(static_cast<int>(link.size()));
+    Point centroid(x / n, y / n);
+
+    for (const Point& candidate : { centroid, CGAL::midpoint(current, centroid) }) {
+        if (candidate != current && in_star_kernel(link, candidate)) {
+            target = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Counter-clockwise link of v, false if v is on the hull or on a constrained edge
+static bool vertex_link(const CDT& cdt, Vertex_handle v, std::vector<Point>& link) {
+    if (cdt.are_there_incident_constraints(v)) return false;
+    auto vc = cdt.incident_vertices(v), done = vc;
+    do {
+        if (cdt.is_infinite(vc)) return false;
+        link.push_back(vc->point());
+    } while (++vc != done);
+    return true;
+}
 
+bool relocation_move(const CDT& cdt, Face_handle face, const SteinerIndex& steinerIndex, int& index, Point& target) {
+    for (int i = 0; i < 3; ++i) {
+        Vertex_handle v = face->vertex(i);
+        auto steiner = steinerIndex.find(v->point());
+        if (steiner == steinerIndex.end()) continue;
+        index = steiner->second;
+
+        std::vector<Point> link;
+        if (vertex_link(cdt, v, link) && relocation_target(link, v->point(), target)) return true;
+    }
+    return false;
+}
+
+bool relocate_steiner_point(CDT& cdt, std::vector<Point>& steinerPoints, int index, const Point& target) {
+    Vertex_handle v;
+    std::vector<Point> link;
+    if (!cdt.is_vertex(steinerPoints[index], v) || !vertex_link(cdt, v, link) || !in_star_kernel(link, target)) return false;
+
+    // Constrained Delaunay triangulations have no constraint-aware move, the hole is re-triangulated instead
+    Face_handle hint = v->face()->neighbor(v->face()->index(v));
+    cdt.remove(v);
+    cdt.insert(target, hint);
+    steinerPoints[index] = target;
+    return true;
+}
+
+// Obtuse count after moving vertex i of face to p, -1 if it cannot move there. The mesh is left unchanged.
+static int trial_relocation_count(FlatMesh& mesh, int face, int i, const Point& p) {
+    mesh.beginTrial();
+    bool moved = mesh.moveVertex(face, i, p);
+    int obtuse_count = mesh.countObtuse();
+    mesh.rollback();
+    return moved ? obtuse_count : -1;
+}
+
+int find_best_relocation(FlatMesh& mesh, int face, int& best_vertex, Point& best_point, const SearchControl& control) {
+    int best_obtuse_count = -1;
+
+    for (int i = 0; i < 3; ++i) {
+        int v = mesh.vertex(face, i);
+        std::vector<int> faces;
+        if (mesh.steinerIndex(v) < 0 || !mesh.star(face, i, faces)) continue;
+
+        std::vector<Point> link;
+        for (int f : faces) {
+            int k = 0;
+            while (mesh.vertex(f, k) != v) k++;
+            link.push_back(mesh.point(mesh.vertex(f, (k + 1) % 3)));
+        }
+
+        Point target;
+        if (!relocation_target(link, mesh.point(v), target)) continue;
+        int obtuse_count = trial_relocation_count(mesh, face, i, target);
+
+        Point snapped;
+        if (obtuse_count >= 0 && control.snap(target, snapped)) {
+            int snapped_count = trial_relocation_count(mesh, face, i, snapped);
+            if (snapped_count >= 0 && snapped_count <= obtuse_count) {
+                target = snapped;
+                obtuse_count = snapped_count;
+            }
+        }
+
+        if (obtuse_count >= 0 && (best_obtuse_count < 0 || obtuse_count < best_obtuse_count)) {
+            best_obtuse_count = obtuse_count;
+            best_vertex = i;
+            best_point = target;
+        }
+    }
+
+    return best_obtuse_count;
+}
+
+// Bring the CDT from the Steiner points it holds (initial_points) to the ones a flat mesh search ended with;
+// the first initial_points.size() entries may have been relocated, the rest are new
+static void sync_steiner_points(CDT& cdt, const std::vector<Point>& initial_points, const std::vector<Point>& steinerPoints) {
+    // Moved points leave their old place first
+    for (size_t i = 0; i < initial_points.size(); ++i) {
+        Vertex_handle v;
+        if (steinerPoints[i] != initial_points[i] && cdt.is_vertex(initial_points[i], v)) {
+            cdt.remove(v);
+        }
+    }
+    for (size_t i = 0; i < initial_points.size(); ++i) {
+        if (steinerPoints[i] != initial_points[i]) {
+            cdt.insert(steinerPoints[i]);
+        }
+    }
+    for (size_t i = initial_points.size(); i < steinerPoints.size(); ++i) {
+        cdt.insert(steinerPoints[i]);
+    }
 }
 
-double local_search(CDT& cdt, std::vector<Point>& steinerPoints, int L) {
-    TriangulationMethod* method = nullptr;
+double local_search(CDT& cdt, std::vector<Point>& steinerPoints, int L, SearchControl& control, int& round) {
     bool done = false;
-    int stopping_criterion = 1;
 
-    double p_sum = 0.0; // Sum for p(n)
-    double p_n;
-    int obtuse_previous = TriangulationUtils::countObtuseTriangles(cdt); // Initial obtuse triangle count
+    // The search runs on the flat mesh, the CDT only receives the final Steiner points
+    FlatMesh mesh = FlatMesh::fromCdt(cdt, steinerPoints);
+    std::vector<Point> initial_points = steinerPoints; // Steiner points already in the CDT, they may be relocated
+
     bool randomized = false;
 
-    const double TOTAL_TIME_LIMIT = 60.0;
-    auto start_time = std::chrono::high_resolution_clock::now();
+    control.begin(mesh.countObtuse(), steinerPoints.size());
 
     while (!done) {
 
-        auto current_time = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> elapsed = current_time - start_time;
-
-        if (elapsed.count() > TOTAL_TIME_LIMIT) {
-            std::cout << "Total time exceeded " << TOTAL_TIME_LIMIT << " seconds! Stopping." << std::endl;
+        if (control.timeExceeded()) {
+            control.log("Total time exceeded ", control.getTimeLimit(), " seconds! Stopping.");
             break;
         }
+        if (control.shouldStop()) break;
 
 
         done = true; 
-        if (stopping_criterion++ == L) break;
-        //std::cout << stopping_criterion << std::endl;
-
-        for (auto face = cdt.finite_faces_begin(); face != cdt.finite_faces_end(); ++face) {
-            Triangle triangle = cdt.triangle(face);
-            auto is_obtuse = TriangulationUtils::isObtuseTriangle(triangle);
-            if (is_obtuse) {
-                int best_method = find_best_method(cdt, face);
-                switch (best_method) {
-                    case 1: method = new ProjectionMethod(); break;
-                    case 2: method = new MidpointMethod(); break;
-                    case 3: method = new CentroidMethod(); break;
-                    case 4: method = new oneCentroidMethod(); break;
-                    case 5: method = new CircumCenterMethod(); break;
-                    case 6: method = nullptr; break; // No improvement possible
+        if (++round == L) break;
+
+        for (int face = 0; face < mesh.numberOfFaces(); ++face) {
+            if (mesh.isObtuse(face)) {
+                Point point;
+                int insert_count;
+                int best_method = find_best_method(mesh, face, point, insert_count, control);
+
+                // Moving a Steiner vertex beats an insertion that removes no more obtuse triangles
+                int vertex;
+                Point target;
+                int relocation_count = find_best_relocation(mesh, face, vertex, target, control);
+                if (relocation_count >= 0 && relocation_count < mesh.countObtuse() && relocation_count <= insert_count) {
+                    int index = mesh.steinerIndex(mesh.vertex(face, vertex));
+                    mesh.moveVertex(face, vertex, target);
+                    steinerPoints[index] = target;
+                    done = false;
+                    break;
                 }
 
-                if (method != nullptr) {
-                    method->execute(cdt, face, steinerPoints);
-                    delete method;
+                if (best_method != 6) { // 6: No improvement possible
+                    mesh.insertPoint(point, face, steinerPoints.size());
+                    steinerPoints.push_back(point);
                     done = false; // Continue iterating
                     break;
                 }
@@ -148,18 +274,19 @@ double local_search(CDT& cdt, std::vector<Point>& steinerPoints, int L) {
         //     done = false; // Rebuild triangulation and continue
         // }
 
-        int obtuse_current = TriangulationUtils::countObtuseTriangles(cdt);
-        if (obtuse_previous > 0 && obtuse_current > 0) {
-            p_n = std::log(static_cast<double>(obtuse_current) / obtuse_previous) /
-                         std::log(static_cast<double>(stopping_criterion + 1) / stopping_criterion);
-            p_sum += std::abs(p_n);
+        control.report(mesh.countObtuse(), steinerPoints.size());
+        if (control.materializeDue()) {
+            mesh.materializePoints();
+            for (auto& p : steinerPoints) {
+                p = TriangulationUtils::exactPoint(p);
+            }
         }
-        obtuse_previous = obtuse_current; // Update for next iteration
     }
 
-    p_sum -= std::abs(p_n); // N-1, we don't want the last one
+    // Sync back to the CGAL triangulation for validation and output
+    sync_steiner_points(cdt, initial_points, steinerPoints);
 
-    double average_p = p_sum / (stopping_criterion - 1);
+    double average_p = control.getConvergenceRate();
     //std::cout << "Local Search Average Convergence Rate (p): " << average_p << std::endl;
     // if (randomized) {
     //     std::cout << "Randomization was applied in Local Search." << std::endl;
@@ -168,6 +295,160 @@ double local_search(CDT& cdt, std::vector<Point>& steinerPoints, int L) {
 }
 
 
+// Beam search
+
+// A partial solution of the beam
+struct BeamState {
+    FlatMesh mesh;
+    std::vector<Point> steinerPoints;
+    double energy;
+};
+
+// Child of a beam state: insert point into face (vertex == -1) or move vertex of face to point
+struct BeamMove {
+    int parent;
+    int face;
+    int vertex;
+    Point point;
+    double energy;
+};
+
+// Give the state its own exact points: copies of a state share the lazy exact values of their points,
+// and evaluating those from several workers at once is a data race
+static void make_exact(BeamState& state) {
+    state.mesh.materializePoints();
+    for (auto& p : state.steinerPoints) {
+        p = TriangulationUtils::exactPoint(p);
+    }
+}
+
+// Moves of one state on up to BEAM_FACES of its obtuse faces, scored by the change of the obtuse count
+static void expand_beam_state(BeamState& state, int parent, const SearchControl& control, std::vector<BeamMove>& moves) {
+    std::vector<int> obtuse_faces;
+    for (int face = 0; face < state.mesh.numberOfFaces(); ++face) {
+        if (state.mesh.isObtuse(face)) obtuse_faces.push_back(face);
+    }
+
+    // Evenly spread sample of the obtuse faces, keeps the expansion cost independent of the instance size
+    size_t stride = std::max<size_t>(1, obtuse_faces.size() / BEAM_FACES);
+    int steiner_count = state.steinerPoints.size();
+
+    for (size_t k = 0; k < obtuse_faces.size() && !control.shouldStop(); k += stride) {
+        int face = obtuse_faces[k];
+
+        SteinerMethods::forEach([&](auto method) {
+            Point candidate;
+            if (!decltype(method)::point(state.mesh, face, candidate)) return;
+
+            int obtuse_count = trial_obtuse_count(state.mesh, candidate, face);
+            snap_candidate(state.mesh, control, face, candidate, obtuse_count);
+            if (obtuse_count < 0) return;
+
+            moves.push_back({ parent, face, -1, candidate, control.energy(obtuse_count, steiner_count + 1) });
+        });
+
+        int vertex;
+        Point target;
+        int obtuse_count = find_best_relocation(state.mesh, face, vertex, target, control);
+        if (obtuse_count >= 0) {
+            moves.push_back({ parent, face, vertex, target, control.energy(obtuse_count, steiner_count) });
+        }
+    }
+}
+
+double beam_search(CDT& cdt, std::vector<Point>& steinerPoints, int width, int depth, SearchControl& control) {
+    std::vector<Point> initial_points = steinerPoints;
+    std::vector<BeamState> beam;
+    beam.push_back({ FlatMesh::fromCdt(cdt, steinerPoints), steinerPoints, 0.0 });
+    make_exact(beam[0]);
+    beam[0].energy = control.energy(beam[0].mesh.countObtuse(), steinerPoints.size());
+
+    BeamState best = beam[0];
+    int stale = 0;      // Steps since the best state last improved
+    int current_width = 1;
+    int max_width = std::max(width, 1);
+    unsigned int threads_available = std::max(1u, std::thread::hardware_concurrency());
+
+    control.begin(best.mesh.countObtuse(), steinerPoints.size());
+
+    while (!beam.empty() && best.mesh.countObtuse() > 0 && stale < depth) {
+        if (control.timeExceeded()) {
+            control.log("Total time exceeded ", control.getTimeLimit(), " seconds! Stopping.");
+            break;
+        }
+        if (control.shouldStop()) break;
+
+        auto step_start = std::chrono::steady_clock::now();
+
+        // Every state owns its mesh and exact points, so states are expanded concurrently
+        std::vector<std::vector<BeamMove>> expansions(beam.size());
+        std::atomic<size_t> next(0);
+        std::vector<std::thread> workers;
+        size_t worker_count = std::min<size_t>(threads_available, beam.size());
+        for (size_t w = 0; w < worker_count; ++w) {
+            workers.emplace_back([&]() {
+                for (size_t i = next++; i < beam.size(); i = next++) {
+                    expand_beam_state(beam[i], i, control, expansions[i]);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        std::vector<BeamMove> moves;
+        for (auto& expansion : expansions) {
+            moves.insert(moves.end(), expansion.begin(), expansion.end());
+        }
+        if (moves.empty()) break;
+
+        // Non improving children stay in the beam, they are the lookahead past a local optimum
+        size_t keep = std::min<size_t>(current_width, moves.size());
+        std::partial_sort(moves.begin(), moves.begin() + keep, moves.end(),
+            [](const BeamMove& lhs, const BeamMove& rhs) { return lhs.energy < rhs.energy; });
+
+        std::vector<BeamState> children;
+        for (size_t i = 0; i < keep; ++i) {
+            const BeamMove& move = moves[i];
+            BeamState child = beam[move.parent];
+            if (move.vertex == -1) {
+                child.mesh.insertPoint(move.point, move.face, child.steinerPoints.size());
+                child.steinerPoints.push_back(move.point);
+            } else {
+                int index = child.mesh.steinerIndex(child.mesh.vertex(move.face, move.vertex));
+                child.mesh.moveVertex(move.face, move.vertex, move.point);
+                child.steinerPoints[index] = move.point;
+            }
+            child.energy = move.energy;
+            make_exact(child);
+            children.push_back(std::move(child));
+        }
+        beam.swap(children);
+
+        if (beam[0].energy < best.energy) {
+            best = beam[0];
+            stale = 0;
+        } else {
+            stale++;
+        }
+
+        // Widen the beam while the budget left covers a step per remaining obtuse triangle, narrow it otherwise
+        std::chrono::duration<double> step_time = std::chrono::steady_clock::now() - step_start;
+        double state_time = step_time.count() * worker_count / expansions.size();
+        double affordable = control.remaining() * threads_available / (state_time * std::max(best.mesh.countObtuse(), 1) + 1e-9);
+        current_width = std::max(1, std::min(max_width, static_cast<int>(affordable)));
+
+        // The children are exact already, materialize_every has nothing left to flatten
+        control.report(best.mesh.countObtuse(), best.steinerPoints.size());
+    }
+
+    steinerPoints = best.steinerPoints;
+    sync_steiner_points(cdt, initial_points, steinerPoints);
+
+    return control.getConvergenceRate();
+}
+
+
 // SA
 
 // Function to calculate the energy of a triangulation
@@ -181,70 +462,103 @@ double randomProbability() {
     return static_cast<double>(std::rand()) / RAND_MAX;
 }
 
-double simulated_annealing(CDT& cdt, std::vector<Point>& steinerPoints, double a, double b, int L) {
-    TriangulationMethod* method = nullptr;
+double randomProbability(std::mt19937& rng) {
+    return std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+}
+
+double simulated_annealing(CDT& cdt, std::vector<Point>& steinerPoints, double a, double b, int L, SearchControl& control, double& temperature) {
     std::vector<Point> dummy_points;
     double energy = calculateEnergy(cdt, a, b, steinerPoints); // Initial energy
-    double T = 1.0;
-    int counter = 1;
     bool randomized = false;
-    std::srand(static_cast<unsigned>(std::time(nullptr)));
+    std::mt19937& rng = control.getRng();
+    TrialArena& arena = TrialArena::local();
+    SteinerIndex steinerIndex = make_steiner_index(steinerPoints);
 
-    double p_sum = 0.0; // Sum for p(n)
-    double p_n;
-    int obtuse_previous = TriangulationUtils::countObtuseTriangles(cdt);
-
-    const double TOTAL_TIME_LIMIT = 80.0;
-    auto start_time = std::chrono::high_resolution_clock::now();
-
-
-    while (T > 0) {
+    control.begin(TriangulationUtils::countObtuseTriangles(cdt), steinerPoints.size());
 
-        auto current_time = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> elapsed = current_time - start_time;
+    while (temperature > 0) {
 
-        if (elapsed.count() > TOTAL_TIME_LIMIT) {
-            std::cout << "Total time exceeded " << TOTAL_TIME_LIMIT << " seconds! Stopping." << std::endl;
+        if (control.timeExceeded()) {
+            control.log("Total time exceeded ", control.getTimeLimit(), " seconds! Stopping.");
             break;
         }
+        if (control.shouldStop()) break;
 
+        // Cool down before the round so that a checkpoint taken during it resumes with the next one
+        double T = temperature;
+        temperature -= 1.0 / L;
         bool improved = false;
 
         for (auto face = cdt.finite_faces_begin(); face != cdt.finite_faces_end(); ++face) {
             Triangle triangle = cdt.triangle(face);
             auto is_obtuse = TriangulationUtils::isObtuseTriangle(triangle);
             if (is_obtuse) {
-                int method_option = std::rand() % 5;
-                switch (method_option) {
-                    case 0: method = new ProjectionMethod(); break;
-                    case 1: method = new MidpointMethod(); break;
-                    case 2: method = new CentroidMethod(); break;
-                    case 3: method = new CircumCenterMethod(); break;
-                    case 4: method = new oneCentroidMethod(); break;
+                // The option after the methods relocates a Steiner vertex of the face, an insertion is drawn if none can move
+                int relocation_index;
+                Point relocation_target;
+                int method_option = rng() % (SteinerMethods::size + 1);
+                if (method_option == SteinerMethods::size && !relocation_move(cdt, face, steinerIndex, relocation_index, relocation_target)) {
+                    method_option = rng() % SteinerMethods::size;
                 }
 
-                CDT test_cdt = cdt;
-                dummy_points = steinerPoints;
-                method->execute(test_cdt, face, dummy_points);
+                bool accepted = false;
+                {
+                    // The faces and vertices of the trial copy live in the arena, only an accepted move is copied
+                    // to the heap; the new points and their lazy exact values are heap allocated either way
+                    ArenaScope trial(&arena);
+                    CDT test_cdt = cdt;
+                    dummy_points = steinerPoints;
+                    bool is_insertion = SteinerMethods::visit(method_option, [&](auto method) {
+                        Point point;
+                        if (decltype(method)::point(cdt, face, point)) {
+                            test_cdt.insert(point);
+                            dummy_points.push_back(point);
+                        }
+                    });
+                    if (!is_insertion) {
+                        relocate_steiner_point(test_cdt, dummy_points, relocation_index, relocation_target);
+                    }
 
-                double newEnergy = calculateEnergy(test_cdt, a, b, dummy_points);
-                double DE = newEnergy - energy;
+                    double newEnergy = calculateEnergy(test_cdt, a, b, dummy_points);
+
+                    // A snapped point replaces the exact one if the energy is no worse
+                    Point snapped;
+                    if (dummy_points.size() > steinerPoints.size() && control.snap(dummy_points.back(), snapped)) {
+                        CDT snapped_cdt = cdt;
+                        snapped_cdt.insert(snapped);
+                        double snappedEnergy = calculateEnergy(snapped_cdt, a, b, dummy_points);
+                        if (snappedEnergy <= newEnergy) {
+                            test_cdt.swap(snapped_cdt);
+                            dummy_points.back() = snapped;
+                            newEnergy = snappedEnergy;
+                        }
+                    }
+                    double DE = newEnergy - energy;
+
+                    if (DE < 0 || std::exp(-DE / T) >= randomProbability(rng)) {
+                        ArenaScope heap(nullptr);
+                        cdt = test_cdt;
+                        if (dummy_points.size() > steinerPoints.size()) {
+                            steinerIndex.emplace(dummy_points.back(), dummy_points.size() - 1);
+                        } else if (!is_insertion && dummy_points[relocation_index] != steinerPoints[relocation_index]) {
+                            steinerIndex.erase(steinerPoints[relocation_index]);
+                            steinerIndex[dummy_points[relocation_index]] = relocation_index;
+                        }
+                        steinerPoints = dummy_points;
+                        energy = newEnergy;
+                        accepted = true;
+                    }
+                }
+                arena.reset();
 
-                if (DE < 0 || std::exp(-DE / T) >= randomProbability()) {
-                    cdt = test_cdt;
-                    steinerPoints = dummy_points;
-                    energy = newEnergy;
+                if (accepted) {
                     improved = true;
 
-                    counter++;
-
-                    int obtuse_current = TriangulationUtils::countObtuseTriangles(cdt);
-                    if (obtuse_previous > 0 && obtuse_current > 0) {
-                        p_n = std::log(static_cast<double>(obtuse_current) / obtuse_previous) /
-                                     std::log(static_cast<double>(counter + 1) / counter);
-                        p_sum += abs(p_n);
+                    control.report(TriangulationUtils::countObtuseTriangles(cdt), steinerPoints.size());
+                    if (control.materializeDue()) {
+                        materialize_points(cdt, steinerPoints);
+                        steinerIndex = make_steiner_index(steinerPoints);
                     }
-                    obtuse_previous = obtuse_current;
                     break;
                 }
             }
@@ -257,15 +571,10 @@ double simulated_annealing(CDT& cdt, std::vector<Point>& steinerPoints, double a
         //     randomized = true;
         // }
 
-        //std::cout << counter << std::endl;
-
-
-        T -= 1.0 / L;
+        //std::cout << control.getIterations() << std::endl;
     }
 
-    p_sum -= std::abs(p_n);
-
-    double average_p = p_sum / (counter - 1);
+    double average_p = control.getConvergenceRate();
     //std::cout << "Simulated Annealing Average Convergence Rate (p): " << average_p << std::endl;
     // if (randomized) {
     //     std::cout << "Randomization was applied in Simulated Annealing." << std::endl;
@@ -276,16 +585,15 @@ double simulated_annealing(CDT& cdt, std::vector<Point>& steinerPoints, double a
 
 
 // Ant Colonies
-void evaluate_method(TriangulationMethod* method, double a, double b, int obtuseCountOld, int obtuseCountNew, std::vector<Point>& steinerPoints, double previousEnergy, CDT& newCdt) {
-    double energyDelta = calculateEnergy(newCdt, a, b, steinerPoints) - previousEnergy;
-    if (energyDelta < 0)
+void evaluate_method(TriangulationMethod* method, double a, double b, int obtuseCountOld, int obtuseCountNew, int steinerCount, AntMove& move) {
+    move.energyDelta = a * (obtuseCountNew - obtuseCountOld) + b; // one Steiner point more
+    // Each method keeps the best move of the cycle
+    if (move.energyDelta < 0 && move.energyDelta < method->getEnergyDelta())
     {
-        int steinerCount = steinerPoints.size();
         double pheromonesDelta = obtuseCountOld == obtuseCountNew ? 0 : 1 / (1 + a * obtuseCountNew + b * steinerCount);
-        method->setAntColonyCdt(newCdt);
-        method->setAntColonySteinerPoints(steinerPoints);
+        method->setAntColonyMove(move);
         method->setPheromonesDelta(pheromonesDelta);
-        method->setEnergyDelta(energyDelta);
+        method->setEnergyDelta(move.energyDelta);
     }
 }
 
@@ -296,55 +604,72 @@ void update_pheromones(TriangulationMethod* method, double pheromonesEvaporation
     method->setPheromones(pheromones);
 }
 
-double ant_colonies(CDT& cdt, std::vector<Point>& steinerPoints, double a, double b, double x , double y, double lambda, double kappa, int L) {
+double ant_colonies(CDT& cdt, std::vector<Point>& steinerPoints, double a, double b, double x , double y, double lambda, double kappa, int L, SearchControl& control,
+                    int& cycle, std::vector<double>& pheromones) {
     int number_of_points = cdt.number_of_vertices();
-    TriangulationMethod* bestMethod = nullptr;
-    std::vector<TriangulationMethod*> methods = std::vector<TriangulationMethod*>(4);
-    methods[0] = new ProjectionMethod();
-    methods[1] = new MidpointMethod();
-    methods[2] = new CentroidMethod();
-    methods[3] = new CircumCenterMethod();  
+    // The methods keep the pheromones of the colony, they live for the whole run
+    ProjectionMethod projectionMethod;
+    MidpointMethod midpointMethod;
+    CentroidMethod quadrilateralMethod;
+    CircumCenterMethod circumCenterMethod;
+    oneCentroidMethod oneCentroid;
+    std::vector<TriangulationMethod*> methods = { &projectionMethod, &midpointMethod, &quadrilateralMethod, &circumCenterMethod };
     std::vector<double> methodProbabilities = std::vector<double>(4);
-    TriangulationMethod* centroidMethod =  new oneCentroidMethod();
-    centroidMethod->setAntColonyCdt(cdt);
-    centroidMethod->setPheromones(0.25); // 1 / number of methods
-    centroidMethod->setEnergyDelta(0);
+    TriangulationMethod* centroidMethod = &oneCentroid;
 
-    // for each method, initialize pheromones
-    for (auto method : methods) {
-        method->setPheromones(0.25); // 1 / number of methods
-        method->setAntColonyCdt(cdt);
-        method->setEnergyDelta(0);
+    // for each method, initialize pheromones, or take those of a resumed colony
+    if (pheromones.size() != methods.size()) {
+        pheromones.assign(methods.size(), 0.25); // 1 / number of methods
     }
+    for (size_t i = 0; i < methods.size(); ++i) {
+        methods[i]->setPheromones(pheromones[i]);
+    }
+
+    // Ants are scored on the flat mesh, only the winning move of a cycle is applied to the CDT
+    FlatMesh mesh = FlatMesh::fromCdt(cdt, steinerPoints);
+    SteinerIndex steinerIndex = make_steiner_index(steinerPoints);
     
-    double p_sum = 0.0; // Sum for p(n)
-    double p_n;
     int obtuse_previous = TriangulationUtils::countObtuseTriangles(cdt);
-    int counter = 1;
-
-
+    std::mt19937& rng = control.getRng();
 
-    const double TOTAL_TIME_LIMIT = 60.0;
-    auto start_time = std::chrono::high_resolution_clock::now();
+    control.begin(obtuse_previous, steinerPoints.size());
 
     //int K = number_of_points / 4;
     int K = kappa;
 
-    for (int c = 0; c < L; c++) // for each cycle
+    for (int c = cycle; c < L; c++) // for each cycle
     {
 
-        auto current_time = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> elapsed = current_time - start_time;
-
-        if (elapsed.count() > TOTAL_TIME_LIMIT) {
-            std::cout << "Total time exceeded " << TOTAL_TIME_LIMIT << " seconds! Stopping." << std::endl;
+        if (control.timeExceeded()) {
+            control.log("Total time exceeded ", control.getTimeLimit(), " seconds! Stopping.");
             break;
         }
+        if (control.shouldStop()) break;
+        if (obtuse_previous == 0) break; // Nothing left for the ants to work on
+
+        for (auto method : methods) {
+            method->setAntColonyMove(AntMove());
+            method->setPheromonesDelta(0);
+            method->setEnergyDelta(0);
+        }
+        AntMove bestRelocation;
 
         for (int ant = 0; ant < K; ant++)
         {
 
-            auto obtuseTriangle = TriangulationUtils::getRandomObtuseTriangle(cdt); // select random obtuse triangle
+            auto obtuseTriangle = TriangulationUtils::getRandomObtuseTriangle(cdt, rng); // select random obtuse triangle
+
+            // Moving a Steiner vertex of the triangle competes with the insertions without adding a point
+            AntMove relocation;
+            int mesh_face, mesh_index;
+            if (relocation_move(cdt, obtuseTriangle, steinerIndex, relocation.relocated, relocation.point)
+                && mesh.locate(steinerPoints[relocation.relocated], mesh_face, mesh_index) == FlatMesh::ON_VERTEX) {
+                int obtuseCountNew = trial_relocation_count(mesh, mesh_face, mesh_index, relocation.point);
+                relocation.energyDelta = a * (obtuseCountNew - mesh.countObtuse());
+                if (obtuseCountNew >= 0 && relocation.energyDelta < bestRelocation.energyDelta) {
+                    bestRelocation = relocation;
+                }
+            }
             // for each method calculate the probability based on pheromones and heuristic
             for (int i = 0; i < 4; i++)
             {
@@ -364,7 +689,7 @@ double ant_colonies(CDT& cdt, std::vector<Point>& steinerPoints, double a, doubl
             }
 
             // Select a method based on the probabilities
-            double random = static_cast<double>(std::rand()) / RAND_MAX;
+            double random = randomProbability(rng);
             double cumulativeProbability = 0;
             TriangulationMethod* selectedMethod = nullptr;
             int methodIndex;
@@ -378,31 +703,32 @@ double ant_colonies(CDT& cdt, std::vector<Point>& steinerPoints, double a, doubl
                 }
             }
 
-            // Execute the selected method
-            CDT newCdt = cdt;
-            std::vector<Point> newSteinerPoints = steinerPoints;
-            selectedMethod->execute(newCdt, obtuseTriangle, newSteinerPoints);
-            // if selected method was circumenter and has same steiner points (not improved) execute oneCentroid
-            if (methodIndex == 3 && steinerPoints.size() == newSteinerPoints.size())
+            if (selectedMethod == nullptr) continue; // Rounding left the probabilities short of 1
+
+            AntMove move;
+            move.method = methodIndex;
+            for (int i = 0; i < 3; i++)
             {
-                centroidMethod->setAntColonyCdt(cdt);
-                centroidMethod->execute(newCdt, obtuseTriangle, newSteinerPoints);
-                int obtuseCountOld = TriangulationUtils::countObtuseTriangles(cdt);
-                int obtuseCountNew = TriangulationUtils::countObtuseTriangles(newCdt);
-                double previousEnergy = calculateEnergy(cdt, a, b, steinerPoints);
-                evaluate_method(centroidMethod, a, b, obtuseCountOld, obtuseCountNew, newSteinerPoints, previousEnergy, newCdt);
-                selectedMethod->setEnergyDelta(centroidMethod->getEnergyDelta());
-                selectedMethod->setPheromonesDelta(centroidMethod->getPheromonesDelta());
-                selectedMethod->setAntColonyCdt(centroidMethod->getAntColonyCdt());
-                selectedMethod->setAntColonySteinerPoints(centroidMethod->getAntColonySteinerPoints());
-            } else {
-                int obtuseCountOld = TriangulationUtils::countObtuseTriangles(cdt);
-                int obtuseCountNew = TriangulationUtils::countObtuseTriangles(newCdt);
-                double previousEnergy = calculateEnergy(cdt, a, b, steinerPoints);
-                evaluate_method(selectedMethod, a, b, obtuseCountOld, obtuseCountNew, newSteinerPoints, previousEnergy, newCdt);
+                move.face[i] = obtuseTriangle->vertex(i);
+            }
+            bool found = selectedMethod->steinerPoint(cdt, obtuseTriangle, move.point);
+            // if selected method was circumenter and has no point inside the domain use oneCentroid
+            if (!found && methodIndex == 3)
+            {
+                found = centroidMethod->steinerPoint(cdt, obtuseTriangle, move.point);
             }
+            if (!found) continue;
+
+            // Score the move on the mesh and undo it
+            int obtuseCountOld = mesh.countObtuse();
+            int obtuseCountNew = trial_obtuse_count(mesh, move.point, 0);
+            snap_candidate(mesh, control, 0, move.point, obtuseCountNew);
+            if (obtuseCountNew < 0) continue;
+
+            evaluate_method(selectedMethod, a, b, obtuseCountOld, obtuseCountNew, steinerPoints.size() + 1, move);
         }
         // Save best triangulation method
+        TriangulationMethod* bestMethod = nullptr;
         for (auto method : methods)
         {
             if (bestMethod == nullptr || method->getEnergyDelta() < bestMethod->getEnergyDelta())
@@ -412,31 +738,360 @@ double ant_colonies(CDT& cdt, std::vector<Point>& steinerPoints, double a, doubl
             }
         }
         // Update pheromones
-        for (auto method : methods)
+        for (size_t i = 0; i < methods.size(); ++i)
         {
-            update_pheromones(method, lambda);
+            update_pheromones(methods[i], lambda);
+            pheromones[i] = methods[i]->getPheromones();
         }
 
-        cdt = bestMethod->getAntColonyCdt();
-        steinerPoints = bestMethod->getAntColonySteinerPoints();
+        // Replay the winning move, the face it was found on is still there
+        const AntMove& best = bestMethod->getAntColonyMove();
+        if (bestRelocation.relocated != -1 && bestRelocation.energyDelta < best.energyDelta) {
+            // The CDT decides, the mesh follows it or is rebuilt so that both keep the same points
+            Point previous = steinerPoints[bestRelocation.relocated];
+            if (relocate_steiner_point(cdt, steinerPoints, bestRelocation.relocated, bestRelocation.point)) {
+                steinerIndex.erase(previous);
+                steinerIndex[bestRelocation.point] = bestRelocation.relocated;
+                int mesh_face, mesh_index;
+                if (mesh.locate(previous, mesh_face, mesh_index) != FlatMesh::ON_VERTEX
+                    || !mesh.moveVertex(mesh_face, mesh_index, bestRelocation.point)) {
+                    mesh = FlatMesh::fromCdt(cdt, steinerPoints);
+                }
+            }
+        } else if (best.method != -1) {
+            Face_handle hint;
+            cdt.is_face(best.face[0], best.face[1], best.face[2], hint);
+            cdt.insert(best.point, hint);
+            mesh.insertPoint(best.point, 0, steinerPoints.size());
+            steinerIndex.emplace(best.point, steinerPoints.size());
+            steinerPoints.push_back(best.point);
+        }
         //CGAL::draw(cdt);
 
-        counter++;
         int obtuse_current = TriangulationUtils::countObtuseTriangles(cdt);
-        if (obtuse_previous > 0 && obtuse_current > 0) {
-            p_n = std::log(static_cast<double>(obtuse_current) / obtuse_previous) /
-                         std::log(static_cast<double>(counter + 1) / counter);
-            p_sum += std::abs(p_n);
-        }
         obtuse_previous = obtuse_current; // Update for next iteration
+        cycle = c + 1;
+        control.report(obtuse_current, steinerPoints.size());
+        if (control.materializeDue()) {
+            materialize_points(cdt, steinerPoints);
+            steinerIndex = make_steiner_index(steinerPoints);
+        }
 
     }
 
-    p_sum -= std::abs(p_n);
-    double average_p = p_sum / (counter - 1);
+    double average_p = control.getConvergenceRate();
     //std::cout << "Ant Colony Average Convergence Rate (p): " << average_p << std::endl;
     // if (randomized) {
     //     std::cout << "Randomization was applied in Simulated Annealing." << std::endl;
     // }
     return average_p;
-}
\ No newline at end of file
+}
+
+// Replace the lazy construction history of the triangulation points by their exact values
+void materialize_points(CDT& cdt, std::vector<Point>& steinerPoints) {
+    for (auto vit = cdt.finite_vertices_begin(); vit != cdt.finite_vertices_end(); ++vit) {
+        vit->set_point(TriangulationUtils::exactPoint(vit->point()));
+    }
+    for (auto& p : steinerPoints) {
+        p = TriangulationUtils::exactPoint(p);
+    }
+}
+
+
+// Steiner pruning
+
+// Hole left by removing a Steiner vertex: its link polygon, the constraint restored through it
+// and the obtuse faces of its star. Points are exact copies taken on the main thread, so candidates
+// can be evaluated concurrently without touching the shared triangulation.
+struct PruneCandidate {
+    Vertex_handle vertex;
+    std::vector<Point> link;
+    bool restoreConstraint = false;
+    Vertex_handle source;
+    Vertex_handle target;
+    Point sourcePoint;
+    Point targetPoint;
+    int obtuseBefore = 0;
+    bool accepted = false;
+};
+
+static bool collect_prune_candidate(const CDT& cdt, Vertex_handle v, PruneCandidate& candidate) {
+    candidate.vertex = v;
+
+    // Constrained edges through v can only be dropped if they continue straight through it
+    std::vector<Vertex_handle> constrained;
+    auto edge = cdt.incident_edges(v), edges_done = edge;
+    do {
+        if (cdt.is_constrained(*edge)) {
+            Face_handle f = edge->first;
+            Vertex_handle a = f->vertex(f->ccw(edge->second));
+            Vertex_handle b = f->vertex(f->cw(edge->second));
+            constrained.push_back(a == v ? b : a);
+        }
+    } while (++edge != edges_done);
+
+    if (constrained.size() == 2) {
+        if (!CGAL::collinear(constrained[0]->point(), v->point(), constrained[1]->point())) return false;
+        candidate.restoreConstraint = true;
+        candidate.source = constrained[0];
+        candidate.target = constrained[1];
+        candidate.sourcePoint = TriangulationUtils::exactPoint(constrained[0]->point());
+        candidate.targetPoint = TriangulationUtils::exactPoint(constrained[1]->point());
+    } else if (!constrained.empty()) {
+        return false;
+    }
+
+    std::vector<Face_handle> faces;
+    auto face = cdt.incident_faces(v), faces_done = face;
+    do {
+        faces.push_back(face);
+    } while (++face != faces_done);
+
+    // Start right after the infinite faces so that the link of a hull vertex is one open path
+    size_t start = 0;
+    bool onHull = false;
+    for (size_t i = 0; i < faces.size(); i++) {
+        if (cdt.is_infinite(faces[i]) && !cdt.is_infinite(faces[(i + 1) % faces.size()])) {
+            start = (i + 1) % faces.size();
+            onHull = true;
+        }
+    }
+
+    Face_handle last;
+    for (size_t i = 0; i < faces.size(); i++) {
+        Face_handle f = faces[(start + i) % faces.size()];
+        if (cdt.is_infinite(f)) break;
+        int index = f->index(v);
+        candidate.link.push_back(TriangulationUtils::exactPoint(f->vertex(f->ccw(index))->point()));
+        if (TriangulationUtils::isObtuseTriangle(cdt.triangle(f))) candidate.obtuseBefore++;
+        last = f;
+    }
+
+    if (onHull) {
+        // Removing a hull corner would shrink the domain
+        candidate.link.push_back(TriangulationUtils::exactPoint(last->vertex(last->cw(last->index(v)))->point()));
+        if (!CGAL::collinear(candidate.link.front(), v->point(), candidate.link.back())) return false;
+    }
+
+    return candidate.link.size() >= 3;
+}
+
+static void evaluate_prune_candidate(PruneCandidate& candidate) {
+    TrialArena& arena = TrialArena::local();
+    {
+        ArenaScope trial(&arena);
+
+        // Constrained Delaunay triangulation of the hole, as CDT::remove rebuilds it
+        CDT hole;
+        for (size_t i = 0; i < candidate.link.size(); i++) {
+            hole.insert_constraint(candidate.link[i], candidate.link[(i + 1) % candidate.link.size()]);
+        }
+        if (candidate.restoreConstraint) {
+            hole.insert_constraint(candidate.sourcePoint, candidate.targetPoint);
+        }
+
+        int obtuseAfter = 0;
+        for (auto fit = hole.finite_faces_begin(); fit != hole.finite_faces_end(); ++fit) {
+            Face_handle face = fit;
+            Point centroid = TriangulationUtils::computeCentroid(face->vertex(0)->point(), face->vertex(1)->point(), face->vertex(2)->point());
+            if (CGAL::bounded_side_2(candidate.link.begin(), candidate.link.end(), centroid) != CGAL::ON_BOUNDED_SIDE) continue;
+            if (TriangulationUtils::isObtuseTriangle(hole.triangle(face))) obtuseAfter++;
+        }
+        candidate.accepted = obtuseAfter <= candidate.obtuseBefore;
+    }
+    arena.reset();
+}
+
+// Obtuse faces incident to any of the vertices, each counted once
+static int stars_obtuse_count(const CDT& cdt, const std::vector<Vertex_handle>& vertices) {
+    std::set<Face_handle> faces;
+    for (Vertex_handle v : vertices) {
+        auto face = cdt.incident_faces(v), done = face;
+        do {
+            if (!cdt.is_infinite(face)) faces.insert(face);
+        } while (++face != done);
+    }
+    int count = 0;
+    for (Face_handle face : faces) {
+        if (TriangulationUtils::isObtuseTriangle(cdt.triangle(face))) count++;
+    }
+    return count;
+}
+
+int prune_steiner_points(CDT& cdt, std::vector<Point>& steinerPoints) {
+    std::set<Point> steinerSet(steinerPoints.begin(), steinerPoints.end());
+    std::set<Point> removed;
+    unsigned int workers = std::max(1u, std::thread::hardware_concurrency());
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        std::set<Point> tried;
+
+        while (true) {
+            // Independent set: no two chosen vertices are adjacent, so their stars share no face
+            std::set<Vertex_handle> blocked;
+            std::vector<PruneCandidate> batch;
+            for (auto vit = cdt.finite_vertices_begin(); vit != cdt.finite_vertices_end(); ++vit) {
+                Vertex_handle v = vit;
+                const Point& p = v->point();
+                if (!steinerSet.count(p) || removed.count(p) || tried.count(p) || blocked.count(v)) continue;
+                tried.insert(p);
+
+                PruneCandidate candidate;
+                if (!collect_prune_candidate(cdt, v, candidate)) continue;
+                auto neighbor = cdt.incident_vertices(v), done = neighbor;
+                do {
+                    blocked.insert(neighbor);
+                } while (++neighbor != done);
+                batch.push_back(std::move(candidate));
+            }
+            if (batch.empty()) break;
+
+            std::atomic<size_t> next{0};
+            auto worker = [&]() {
+                for (size_t i = next++; i < batch.size(); i = next++) {
+                    evaluate_prune_candidate(batch[i]);
+                }
+            };
+            std::vector<std::thread> threads;
+            for (unsigned int t = 1; t < std::min<size_t>(workers, batch.size()); t++) {
+                threads.emplace_back(worker);
+            }
+            worker();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            // Ties between cocircular points may be broken differently than in the hole, so every removal is
+            // checked again on the triangulation; it only changes faces of the stars of the link vertices
+            for (auto& candidate : batch) {
+                if (!candidate.accepted) continue;
+                Point point = candidate.vertex->point();
+                std::vector<Vertex_handle> link;
+                auto neighbor = cdt.incident_vertices(candidate.vertex), done = neighbor;
+                do {
+                    if (!cdt.is_infinite(neighbor)) link.push_back(neighbor);
+                } while (++neighbor != done);
+
+                int obtuseBefore = stars_obtuse_count(cdt, link);
+                if (candidate.restoreConstraint) cdt.remove_incident_constraints(candidate.vertex);
+                cdt.remove(candidate.vertex);
+                if (candidate.restoreConstraint) cdt.insert_constraint(candidate.source, candidate.target);
+
+                if (stars_obtuse_count(cdt, link) > obtuseBefore) {
+                    // Inserting the point on the restored constraint splits it again
+                    cdt.insert(point);
+                    continue;
+                }
+                removed.insert(point);
+                changed = true;
+            }
+        }
+    }
+
+    int count = steinerPoints.size();
+    steinerPoints.erase(std::remove_if(steinerPoints.begin(), steinerPoints.end(),
+        [&](const Point& p) { return removed.count(p) > 0; }), steinerPoints.end());
+    return count - steinerPoints.size();
+}
+
+
+// EDGE FLIPS
+
+// Largest angle of a triangle in radians, opposite its longest edge
+static double max_angle(const Point& p, const Point& q, const Point& r) {
+    double a = CGAL::to_double(CGAL::squared_distance(q, r));
+    double b = CGAL::to_double(CGAL::squared_distance(p, r));
+    double c = CGAL::to_double(CGAL::squared_distance(p, q));
+    if (a < b) std::swap(a, b);
+    if (a < c) std::swap(a, c);
+    if (b <= 0 || c <= 0) return M_PI;
+    double cosine = (b + c - a) / (2 * std::sqrt(b * c));
+    return std::acos(std::max(-1.0, std::min(1.0, cosine)));
+}
+
+// Pending flip, ordered by removed obtuse triangles first and then by the decrease of the largest angle
+struct FlipCandidate {
+    int obtuseGain;
+    double angleGain;
+    Vertex_handle source;
+    Vertex_handle target;
+
+    bool operator<(const FlipCandidate& other) const {
+        if (obtuseGain != other.obtuseGain) return obtuseGain < other.obtuseGain;
+        return angleGain < other.angleGain;
+    }
+};
+
+// Gain of flipping the edge opposite vertex i of f, false if the edge cannot be flipped
+static bool flip_gain(const CDT& cdt, Face_handle f, int i, int& obtuseGain, double& angleGain) {
+    Face_handle g = f->neighbor(i);
+    if (cdt.is_infinite(f) || cdt.is_infinite(g) || f->is_constrained(i)) return false;
+
+    const Point& p = f->vertex(i)->point();
+    const Point& a = f->vertex(f->ccw(i))->point();
+    const Point& b = f->vertex(f->cw(i))->point();
+    const Point& w = g->vertex(cdt.mirror_index(f, i))->point();
+
+    // The quadrilateral p, a, w, b must be strictly convex
+    if (CGAL::orientation(p, a, w) != CGAL::LEFT_TURN || CGAL::orientation(p, w, b) != CGAL::LEFT_TURN) return false;
+
+    int obtuseBefore = TriangulationUtils::isObtuseTriangle(p, a, b) + TriangulationUtils::isObtuseTriangle(a, w, b);
+    int obtuseAfter = TriangulationUtils::isObtuseTriangle(p, a, w) + TriangulationUtils::isObtuseTriangle(p, w, b);
+    obtuseGain = obtuseBefore - obtuseAfter;
+    angleGain = std::max(max_angle(p, a, b), max_angle(a, w, b)) - std::max(max_angle(p, a, w), max_angle(p, w, b));
+    return true;
+}
+
+static bool worth_flipping(int obtuseGain, double angleGain) {
+    const double ANGLE_EPSILON = 1e-9; // float ties must not make the flips cycle
+    return obtuseGain > 0 || (obtuseGain == 0 && angleGain > ANGLE_EPSILON);
+}
+
+static void push_flip(const CDT& cdt, Face_handle f, int i, std::priority_queue<FlipCandidate>& queue) {
+    int obtuseGain;
+    double angleGain;
+    if (flip_gain(cdt, f, i, obtuseGain, angleGain) && worth_flipping(obtuseGain, angleGain)) {
+        queue.push({ obtuseGain, angleGain, f->vertex(f->ccw(i)), f->vertex(f->cw(i)) });
+    }
+}
+
+int flip_edges(CDT& cdt) {
+    std::priority_queue<FlipCandidate> queue;
+    for (auto eit = cdt.finite_edges_begin(); eit != cdt.finite_edges_end(); ++eit) {
+        push_flip(cdt, eit->first, eit->second, queue);
+    }
+
+    int flips = 0;
+    while (!queue.empty()) {
+        FlipCandidate candidate = queue.top();
+        queue.pop();
+
+        // Entries are not removed when their edge changes, recheck them when they come up
+        Face_handle f;
+        int i;
+        if (!cdt.is_edge(candidate.source, candidate.target, f, i)) continue;
+        int obtuseGain;
+        double angleGain;
+        if (!flip_gain(cdt, f, i, obtuseGain, angleGain) || !worth_flipping(obtuseGain, angleGain)) continue;
+        if (obtuseGain != candidate.obtuseGain || angleGain != candidate.angleGain) {
+            queue.push({ obtuseGain, angleGain, candidate.source, candidate.target });
+            continue;
+        }
+
+        // Both faces are reused by the flip
+        Face_handle g = f->neighbor(i);
+        cdt.flip(f, i);
+        flips++;
+
+        // The four outer edges of the two new faces may have become worth flipping
+        for (Face_handle face : { f, g }) {
+            for (int j = 0; j < 3; j++) {
+                if (face->neighbor(j) == f || face->neighbor(j) == g) continue;
+                push_flip(cdt, face, j, queue);
+            }
+        }
+    }
+    return flips;
+}
@@ -1,36 +1,23 @@
 #include <iostream>
 #include "triangulationUtils.hpp"
 #include "centroidMethod.hpp"
+#include "steinerMethods.hpp"
 
 CentroidMethod::CentroidMethod() {
 }
 
-void CentroidMethod::insertCentroid(CDT& cdt, Face_handle face, std::vector<Point>& steiner_points) {
-
-    if (cdt.is_infinite(face)) return;  // Ignore infinite faces
-
-    for (int i = 0; i < 3; ++i) {
-        Face_handle neighbor = face->neighbor(i);
-        
-        if (cdt.is_infinite(neighbor)) continue;  // Ignore infinite neighbors
+bool CentroidMethod::steinerPoint(const CDT& cdt, Face_handle face, Point& point) {
+    // Centroid of the quadrilateral formed by the two obtuse triangles, only the first obtuse neighbor
+    return QuadrilateralCentroidPoint::point(cdt, face, point);
+}
 
-        Triangle triangle = cdt.triangle(neighbor);
-        auto is_obtuse = TriangulationUtils::isObtuseTriangle(triangle);
-        if (is_obtuse) {
-            Point A = face->vertex((i + 1) % 3)->point();
-            Point B = face->vertex((i + 2) % 3)->point();
-            Point C = neighbor->vertex((neighbor->index(face) + 1) % 3)->point();
-            Point D = neighbor->vertex((neighbor->index(face) + 2) % 3)->point();
+void CentroidMethod::insertCentroid(CDT& cdt, Face_handle face, std::vector<Point>& steiner_points) {
+    Point centroid;
+    if (!steinerPoint(cdt, face, centroid)) return;  // Infinite face or no obtuse neighbor
 
-            // Compute centroid of the quadrilateral formed by the two obtuse triangles
-            Point centroid = TriangulationUtils::quadrilateralCentroid(A, B, C, D);
-            
-            // Insert the centroid as a steiner point
-            cdt.insert(centroid);
-            steiner_points.push_back(centroid);
-            break;  // Only the first obtuse neighbor
-        }
-    }
+    // Insert the centroid as a steiner point
+    cdt.insert(centroid);
+    steiner_points.push_back(centroid);
 }
 
 // Function to check if inserting the centroid is beneficial
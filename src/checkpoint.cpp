@@ -0,0 +1,158 @@
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdint>
+#include <limits>
+#include <gmpxx.h>
+#include "checkpoint.hpp"
+
+// File layout version, bump when the layout changes
+#define CHECKPOINT_MAGIC "OTCK"
+#define CHECKPOINT_VERSION 2
+
+template <class T>
+static void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+static T readValue(std::istream& in) {
+    T value;
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw std::runtime_error("Truncated checkpoint");
+    }
+    return value;
+}
+
+static uint64_t remainingBytes(std::istream& in) {
+    std::streampos position = in.tellg();
+    if (position < 0) return std::numeric_limits<uint64_t>::max();
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(position);
+    return end > position ? static_cast<uint64_t>(end - position) : 0;
+}
+
+// Length or count of items of at least one byte each, checked against the file before anything
+// is allocated for it so that a corrupt checkpoint cannot ask for gigabytes
+static uint32_t checkLength(std::istream& in, uint32_t length) {
+    if (length > remainingBytes(in)) {
+        throw std::runtime_error("Corrupt length in checkpoint");
+    }
+    return length;
+}
+
+static void writeInteger(std::ostream& out, const mpz_class& value) {
+    std::vector<unsigned char> bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8);
+    size_t count = 0;
+    mpz_export(bytes.data(), &count, 1, 1, 1, 0, value.get_mpz_t());
+    writeValue<int8_t>(out, static_cast<int8_t>(sgn(value)));
+    writeValue<uint32_t>(out, static_cast<uint32_t>(count));
+    out.write(reinterpret_cast<const char*>(bytes.data()), count);
+}
+
+static mpz_class readInteger(std::istream& in) {
+    int8_t sign = readValue<int8_t>(in);
+    uint32_t count = checkLength(in, readValue<uint32_t>(in));
+    std::vector<unsigned char> bytes(count);
+    if (!in.read(reinterpret_cast<char*>(bytes.data()), count)) {
+        throw std::runtime_error("Truncated checkpoint");
+    }
+    mpz_class value;
+    mpz_import(value.get_mpz_t(), count, 1, 1, 1, 0, bytes.data());
+    return sign < 0 ? mpz_class(-value) : value;
+}
+
+void CheckpointUtils::writeString(std::ostream& out, const std::string& value) {
+    writeValue<uint32_t>(out, static_cast<uint32_t>(value.size()));
+    out.write(value.data(), value.size());
+}
+
+std::string CheckpointUtils::readString(std::istream& in) {
+    uint32_t size = checkLength(in, readValue<uint32_t>(in));
+    std::string value(size, '\0');
+    if (!in.read(&value[0], size)) {
+        throw std::runtime_error("Truncated checkpoint");
+    }
+    return value;
+}
+
+void CheckpointUtils::writeRational(std::ostream& out, const FT& value) {
+    const auto& exact = CGAL::exact(value);
+    writeInteger(out, exact.get_num());
+    writeInteger(out, exact.get_den());
+}
+
+FT CheckpointUtils::readRational(std::istream& in) {
+    mpz_class num = readInteger(in);
+    mpz_class den = readInteger(in);
+    FT::ET rational(num, den);
+    rational.canonicalize();
+    return FT(rational);
+}
+
+void CheckpointUtils::writeCheckpoint(const std::string& filename, const Checkpoint& checkpoint) {
+    // Write next to the target and rename so that a crash never leaves half a checkpoint
+    std::string temporary = filename + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        if (!out) {
+            throw std::runtime_error("Cannot write checkpoint " + temporary);
+        }
+        out.write(CHECKPOINT_MAGIC, 4);
+        writeValue<uint32_t>(out, CHECKPOINT_VERSION);
+        writeString(out, checkpoint.instance_uid);
+        writeValue<int32_t>(out, checkpoint.num_points);
+        writeString(out, checkpoint.engine);
+        writeString(out, checkpoint.parameters.dump());
+        writeString(out, checkpoint.state.dump());
+        writeValue<int32_t>(out, checkpoint.iterations);
+        writeValue<double>(out, checkpoint.elapsed);
+        writeString(out, checkpoint.rng_state);
+        writeValue<uint32_t>(out, static_cast<uint32_t>(checkpoint.steiner_points.size()));
+        for (const auto& p : checkpoint.steiner_points) {
+            writeRational(out, p.x());
+            writeRational(out, p.y());
+        }
+        out.close();
+        if (!out) {
+            throw std::runtime_error("Cannot write checkpoint " + temporary);
+        }
+    }
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        throw std::runtime_error("Cannot replace checkpoint " + filename);
+    }
+}
+
+Checkpoint CheckpointUtils::readCheckpoint(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open checkpoint " + filename);
+    }
+
+    char magic[4];
+    if (!in.read(magic, 4) || std::string(magic, 4) != CHECKPOINT_MAGIC) {
+        throw std::runtime_error(filename + " is not a checkpoint");
+    }
+    if (readValue<uint32_t>(in) != CHECKPOINT_VERSION) {
+        throw std::runtime_error("Unsupported checkpoint version in " + filename);
+    }
+
+    Checkpoint checkpoint;
+    checkpoint.instance_uid = readString(in);
+    checkpoint.num_points = readValue<int32_t>(in);
+    checkpoint.engine = readString(in);
+    checkpoint.parameters = nlohmann::json::parse(readString(in));
+    checkpoint.state = nlohmann::json::parse(readString(in));
+    checkpoint.iterations = readValue<int32_t>(in);
+    checkpoint.elapsed = readValue<double>(in);
+    checkpoint.rng_state = readString(in);
+    uint32_t count = checkLength(in, readValue<uint32_t>(in));
+    checkpoint.steiner_points.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        FT x = readRational(in);
+        FT y = readRational(in);
+        checkpoint.steiner_points.emplace_back(x, y);
+    }
+    return checkpoint;
+}
@@ -1,21 +1,20 @@
 #include <iostream>
 #include "circumCenterMethod.hpp"
 #include "triangulationUtils.hpp"
+#include "steinerMethods.hpp"
 
 CircumCenterMethod::CircumCenterMethod() {
 }
 
+bool CircumCenterMethod::steinerPoint(const CDT& cdt, Face_handle face, Point& point) {
+    // Circumcenter, only if it lies inside the convex hull
+    return CircumcenterPoint::point(cdt, face, point);
+}
+
 // Function to insert the circumcenter of an obtuse triangle into the triangulation
 void CircumCenterMethod::insertCircumcenter(CDT& cdt, Face_handle face, std::vector<Point>& steiner_points) {
-
-    // Find circumcenter
-    Point p1 = face->vertex(0)->point();
-    Point p2 = face->vertex(1)->point();
-    Point p3 = face->vertex(2)->point();
-    Point circumcenter = CGAL::circumcenter(p1, p2, p3);
-
-
-    if (  TriangulationUtils::is_point_inside_convex_hull(cdt, circumcenter)  ){
+    Point circumcenter;
+    if (steinerPoint(cdt, face, circumcenter)) {
         // Insert circumcenter and update triangulation
         CDT::Vertex_handle new_vertex = cdt.insert(circumcenter);
         steiner_points.push_back(circumcenter);
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "solutionFormat.hpp"
+
+namespace fs = std::filesystem;
+
+// Seconds to load a solution in its own format
+static double load_time(const fs::path& path) {
+    auto start = std::chrono::steady_clock::now();
+    SolutionFormat::load(path.string());
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Converts one solution, binary files become JSON and JSON files become binary; with check the
+// result is read back and compared with the source
+static bool convert(const fs::path& input, const fs::path& output, bool check) {
+    bool binary = SolutionFormat::isBinary(input.string());
+    nlohmann::json solution = SolutionFormat::load(input.string());
+    if (binary) {
+        std::ofstream out(output);
+        out << solution.dump(4);
+    } else {
+        SolutionFormat::write(output.string(), solution);
+    }
+
+    std::cout << input.filename().string() << " -> " << output.filename().string()
+              << "  " << fs::file_size(input) << " -> " << fs::file_size(output) << " bytes";
+    if (check) {
+        std::cout << ", load " << load_time(input) << "s -> " << load_time(output) << "s";
+        if (SolutionFormat::load(output.string()) != solution) {
+            std::cout << std::endl << "     error: the converted solution differs" << std::endl;
+            return false;
+        }
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+static fs::path converted_name(const fs::path& input) {
+    fs::path output = input.filename();
+    return output.replace_extension(SolutionFormat::isBinary(input.string()) ? ".json" : ".bin");
+}
+
+int main(int argc, const char* argv[]) {
+    bool check = false;
+    bool directories = false;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--check") check = true;
+        else if (arg == "--dir") directories = true;
+        else paths.push_back(arg);
+    }
+
+    if (paths.size() != 2) {
+        std::cout << "Usage: " << argv[0] << " [--check] <solution.json|solution.bin> <output>" << std::endl;
+        std::cout << "       " << argv[0] << " [--check] --dir <solutions> <output dir>" << std::endl;
+        return 1;
+    }
+
+    if (!directories) {
+        try {
+            return convert(paths[0], paths[1], check) ? 0 : 1;
+        } catch (const std::exception& e) {
+            std::cerr << paths[0] << ": " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Every .json and .bin file of the directory, x.output.json becomes x.output.bin and the other way round
+    fs::create_directories(paths[1]);
+    std::vector<fs::path> inputs;
+    for (const auto& entry : fs::directory_iterator(paths[0])) {
+        if (entry.path().extension() == ".json" || entry.path().extension() == ".bin") inputs.push_back(entry.path());
+    }
+    std::sort(inputs.begin(), inputs.end());
+
+    int failed = 0;
+    for (const auto& input : inputs) {
+        try {
+            if (!convert(input, fs::path(paths[1]) / converted_name(input), check)) failed++;
+        } catch (const std::exception& e) {
+            std::cerr << input.string() << ": " << e.what() << std::endl;
+            failed++;
+        }
+    }
+    std::cout << inputs.size() << " solutions, " << failed << " failed" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
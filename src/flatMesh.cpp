@@ -0,0 +1,392 @@
+#include <map>
+#include <unordered_map>
+#include "flatMesh.hpp"
+#include "triangulationUtils.hpp"
+
+static bool isObtuseFace(const Point& a, const Point& b, const Point& c) {
+    // Predicates only, no lazy constructions are created
+    return CGAL::angle(a, b, c) == CGAL::OBTUSE
+        || CGAL::angle(b, c, a) == CGAL::OBTUSE
+        || CGAL::angle(c, a, b) == CGAL::OBTUSE;
+}
+
+FlatMesh FlatMesh::fromCdt(const CDT& cdt, const std::vector<Point>& steinerPoints) {
+    FlatMesh mesh;
+    std::unordered_map<const void*, int> vertexIndex;
+    std::unordered_map<const void*, int> faceIndex;
+
+    std::map<Point, int> steinerIndex;
+    for (size_t i = 0; i < steinerPoints.size(); ++i) {
+        steinerIndex.emplace(steinerPoints[i], i);
+    }
+
+    for (auto vit = cdt.finite_vertices_begin(); vit != cdt.finite_vertices_end(); ++vit) {
+        vertexIndex[&*vit] = mesh.points.size();
+        mesh.points.push_back(vit->point());
+        auto steiner = steinerIndex.find(vit->point());
+        mesh.steinerIndices.push_back(steiner != steinerIndex.end() ? steiner->second : -1);
+    }
+
+    int faces = 0;
+    for (auto fit = cdt.finite_faces_begin(); fit != cdt.finite_faces_end(); ++fit) {
+        faceIndex[&*fit] = faces++;
+    }
+
+    mesh.faceVertices.resize(3 * faces);
+    mesh.faceNeighbors.resize(3 * faces);
+    mesh.faceConstraints.assign(faces, 0);
+    mesh.faceObtuse.assign(faces, 0);
+
+    for (auto fit = cdt.finite_faces_begin(); fit != cdt.finite_faces_end(); ++fit) {
+        int face = faceIndex[&*fit];
+        for (int i = 0; i < 3; ++i) {
+            mesh.faceVertices[3 * face + i] = vertexIndex[&*fit->vertex(i)];
+
+            Face_handle neighbor = fit->neighbor(i);
+            mesh.faceNeighbors[3 * face + i] = cdt.is_infinite(neighbor) ? -1 : faceIndex[&*neighbor];
+
+            if (fit->is_constrained(i)) {
+                mesh.faceConstraints[face] |= 1 << i;
+            }
+        }
+        mesh.updateObtuse(face);
+    }
+
+    return mesh;
+}
+
+int FlatMesh::indexOf(int face, int other) const {
+    for (int i = 0; i < 3; ++i) {
+        if (neighbor(face, i) == other) return i;
+    }
+    return -1;
+}
+
+FlatMesh::Location FlatMesh::classify(const Point& p, int f, int& face, int& index) const {
+    face = f;
+    for (int i = 0; i < 3; ++i) {
+        if (points[vertex(f, i)] == p) {
+            index = i;
+            return ON_VERTEX;
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        if (CGAL::orientation(points[vertex(f, (i + 1) % 3)], points[vertex(f, (i + 2) % 3)], p) == CGAL::COLLINEAR) {
+            index = i;
+            return ON_EDGE;
+        }
+    }
+    return INSIDE;
+}
+
+FlatMesh::Location FlatMesh::locate(const Point& p, int& face, int& index, int hint) const {
+    if (numberOfFaces() == 0) return OUTSIDE;
+
+    // Visibility walk, the rotating start edge keeps it from cycling in non Delaunay regions
+    int f = hint >= 0 && hint < numberOfFaces() ? hint : 0;
+    int max_steps = numberOfFaces() + 3;
+
+    for (int step = 0; step < max_steps; ++step) {
+        int next = -2;
+        for (int k = 0; k < 3; ++k) {
+            int i = (k + step) % 3;
+            if (CGAL::orientation(points[vertex(f, (i + 1) % 3)], points[vertex(f, (i + 2) % 3)], p) == CGAL::RIGHT_TURN) {
+                next = neighbor(f, i);
+                break;
+            }
+        }
+
+        if (next == -2) return classify(p, f, face, index);
+        if (next == -1) return OUTSIDE; // Crossed the convex hull
+        f = next;
+    }
+
+    // Fall back to a linear scan
+    for (f = 0; f < numberOfFaces(); ++f) {
+        bool inside = true;
+        for (int i = 0; i < 3 && inside; ++i) {
+            inside = CGAL::orientation(points[vertex(f, (i + 1) % 3)], points[vertex(f, (i + 2) % 3)], p) != CGAL::RIGHT_TURN;
+        }
+        if (inside) return classify(p, f, face, index);
+    }
+    return OUTSIDE;
+}
+
+bool FlatMesh::insertPoint(const Point& p, int hint, int steiner) {
+    int face, index;
+    Location location = locate(p, face, index, hint);
+    if (location == OUTSIDE || location == ON_VERTEX) return false;
+
+    int v = points.size();
+    points.push_back(p);
+    steinerIndices.push_back(steiner);
+
+    if (location == INSIDE) {
+        splitFace(face, v);
+    } else {
+        splitEdge(face, index, v);
+    }
+    return true;
+}
+
+bool FlatMesh::flip(int f, int i) {
+    int g = neighbor(f, i);
+    if (g == -1 || isConstrained(f, i)) return false;
+
+    int j = indexOf(g, f);
+    int vi = vertex(f, i), a = vertex(f, (i + 1) % 3), b = vertex(f, (i + 2) % 3);
+    int w = vertex(g, j);
+
+    // The quadrilateral vi, a, w, b must be strictly convex
+    if (CGAL::orientation(points[vi], points[a], points[w]) != CGAL::LEFT_TURN) return false;
+    if (CGAL::orientation(points[vi], points[w], points[b]) != CGAL::LEFT_TURN) return false;
+
+    int nfa = neighbor(f, (i + 1) % 3), nfb = neighbor(f, (i + 2) % 3);
+    int ngb = neighbor(g, (j + 1) % 3), nga = neighbor(g, (j + 2) % 3);
+    unsigned char cfa = isConstrained(f, (i + 1) % 3), cfb = isConstrained(f, (i + 2) % 3);
+    unsigned char cgb = isConstrained(g, (j + 1) % 3), cga = isConstrained(g, (j + 2) % 3);
+
+    setFace(f, vi, a, w, ngb, g, nfb, cgb | (cfb << 2));
+    setFace(g, vi, w, b, nga, nfa, f, cga | (cfa << 1));
+    replaceNeighbor(ngb, g, f);
+    replaceNeighbor(nfa, f, g);
+    return true;
+}
+
+void FlatMesh::splitFace(int f, int p) {
+    int a = vertex(f, 0), b = vertex(f, 1), c = vertex(f, 2);
+    int na = neighbor(f, 0), nb = neighbor(f, 1), nc = neighbor(f, 2);
+    unsigned char constraints = faceConstraints[f];
+
+    int g = addFace();
+    int h = addFace();
+    setFace(f, p, b, c, na, g, h, constraints & 1);
+    setFace(g, p, c, a, nb, h, f, (constraints >> 1) & 1);
+    setFace(h, p, a, b, nc, f, g, (constraints >> 2) & 1);
+    replaceNeighbor(nb, f, g);
+    replaceNeighbor(nc, f, h);
+
+    std::vector<std::pair<int, int>> edges = { { f, 0 }, { g, 0 }, { h, 0 } };
+    legalize(edges);
+}
+
+void FlatMesh::splitEdge(int f, int i, int p) {
+    int vi = vertex(f, i), a = vertex(f, (i + 1) % 3), b = vertex(f, (i + 2) % 3);
+    int nfa = neighbor(f, (i + 1) % 3), nfb = neighbor(f, (i + 2) % 3);
+    unsigned char cab = isConstrained(f, i);
+    unsigned char cfa = isConstrained(f, (i + 1) % 3), cfb = isConstrained(f, (i + 2) % 3);
+    int g = neighbor(f, i);
+
+    int f2 = addFace();
+    std::vector<std::pair<int, int>> edges;
+
+    if (g == -1) {
+        // Hull edge, only one side to split
+        setFace(f, vi, a, p, -1, f2, nfb, cab | (cfb << 2));
+        setFace(f2, vi, p, b, -1, nfa, f, cab | (cfa << 1));
+        replaceNeighbor(nfa, f, f2);
+        edges = { { f, 2 }, { f2, 1 } };
+    } else {
+        int j = indexOf(g, f);
+        int w = vertex(g, j);
+        int ngb = neighbor(g, (j + 1) % 3), nga = neighbor(g, (j + 2) % 3);
+        unsigned char cgb = isConstrained(g, (j + 1) % 3), cga = isConstrained(g, (j + 2) % 3);
+
+        int g2 = addFace();
+        setFace(f, vi, a, p, g2, f2, nfb, cab | (cfb << 2));
+        setFace(f2, vi, p, b, g, nfa, f, cab | (cfa << 1));
+        setFace(g, w, b, p, f2, g2, nga, cab | (cga << 2));
+        setFace(g2, w, p, a, f, ngb, g, cab | (cgb << 1));
+        replaceNeighbor(nfa, f, f2);
+        replaceNeighbor(ngb, g, g2);
+        edges = { { f, 2 }, { f2, 1 }, { g, 2 }, { g2, 1 } };
+    }
+
+    legalize(edges);
+}
+
+// Lawson flips around a new vertex; each entry is a face and the index of the new vertex in it
+void FlatMesh::legalize(std::vector<std::pair<int, int>>& edges) {
+    while (!edges.empty()) {
+        auto [f, k] = edges.back();
+        edges.pop_back();
+
+        if (isConstrained(f, k)) continue;
+        int g = neighbor(f, k);
+        if (g == -1) continue;
+
+        const Point& w = points[vertex(g, indexOf(g, f))];
+        if (CGAL::side_of_oriented_circle(points[vertex(f, 0)], points[vertex(f, 1)], points[vertex(f, 2)], w) != CGAL::ON_POSITIVE_SIDE) continue;
+
+        // After the flip the new vertex is at index 0 of both faces
+        if (flip(f, k)) {
+            edges.push_back({ f, 0 });
+            edges.push_back({ g, 0 });
+        }
+    }
+}
+
+bool FlatMesh::star(int face, int i, std::vector<int>& faces) const {
+    faces.clear();
+    int v = vertex(face, i);
+    int f = face, k = i;
+    do {
+        // The edge from v to the last vertex of f is shared with the next face counter-clockwise
+        if (isConstrained(f, (k + 1) % 3)) return false;
+        faces.push_back(f);
+        int next = neighbor(f, (k + 1) % 3);
+        if (next == -1) return false;
+        f = next;
+        for (k = 0; vertex(f, k) != v; ++k) {}
+    } while (f != face);
+    return true;
+}
+
+bool FlatMesh::moveVertex(int face, int i, const Point& p) {
+    std::vector<int> faces;
+    if (!star(face, i, faces)) return false;
+
+    int v = vertex(face, i);
+    for (int f : faces) {
+        int k = 0;
+        while (vertex(f, k) != v) k++;
+        if (CGAL::orientation(points[vertex(f, (k + 1) % 3)], points[vertex(f, (k + 2) % 3)], p) != CGAL::LEFT_TURN) return false;
+    }
+
+    if (recording && v < static_cast<int>(savedVertices)) {
+        movedPoints.emplace_back(v, points[v]);
+    }
+    points[v] = p;
+
+    // The star keeps its combinatorics, only its faces and their outer edges need checking
+    std::vector<std::pair<int, int>> edges;
+    for (int f : faces) {
+        saveFace(f);
+        updateObtuse(f);
+        for (int k = 0; k < 3; ++k) {
+            edges.push_back({ f, k });
+        }
+    }
+    restoreDelaunay(edges);
+    return true;
+}
+
+// Lawson flips over arbitrary edges, each entry is a face and the index of the vertex opposite the edge
+void FlatMesh::restoreDelaunay(std::vector<std::pair<int, int>>& edges) {
+    while (!edges.empty()) {
+        auto [f, k] = edges.back();
+        edges.pop_back();
+
+        if (isConstrained(f, k)) continue;
+        int g = neighbor(f, k);
+        if (g == -1) continue;
+
+        const Point& w = points[vertex(g, indexOf(g, f))];
+        if (CGAL::side_of_oriented_circle(points[vertex(f, 0)], points[vertex(f, 1)], points[vertex(f, 2)], w) != CGAL::ON_POSITIVE_SIDE) continue;
+
+        // The diagonal is edge 1 of f and edge 2 of g after the flip, the other four are checked again
+        if (flip(f, k)) {
+            edges.push_back({ f, 0 });
+            edges.push_back({ f, 2 });
+            edges.push_back({ g, 0 });
+            edges.push_back({ g, 1 });
+        }
+    }
+}
+
+int FlatMesh::addFace() {
+    int face = numberOfFaces();
+    faceVertices.insert(faceVertices.end(), 3, -1);
+    faceNeighbors.insert(faceNeighbors.end(), 3, -1);
+    faceConstraints.push_back(0);
+    faceObtuse.push_back(0);
+    return face;
+}
+
+void FlatMesh::saveFace(int face) {
+    if (!recording || face >= static_cast<int>(savedFaces)) return;
+
+    FaceRecord record;
+    record.face = face;
+    for (int i = 0; i < 3; ++i) {
+        record.vertices[i] = faceVertices[3 * face + i];
+        record.neighbors[i] = faceNeighbors[3 * face + i];
+    }
+    record.constraints = faceConstraints[face];
+    record.obtuse = faceObtuse[face];
+    journal.push_back(record);
+}
+
+void FlatMesh::setFace(int face, int v0, int v1, int v2, int n0, int n1, int n2, unsigned char constraints) {
+    saveFace(face);
+    int* v = &faceVertices[3 * face];
+    int* n = &faceNeighbors[3 * face];
+    v[0] = v0; v[1] = v1; v[2] = v2;
+    n[0] = n0; n[1] = n1; n[2] = n2;
+    faceConstraints[face] = constraints;
+    updateObtuse(face);
+}
+
+void FlatMesh::setNeighbor(int face, int i, int other) {
+    saveFace(face);
+    faceNeighbors[3 * face + i] = other;
+}
+
+void FlatMesh::replaceNeighbor(int face, int oldNeighbor, int newNeighbor) {
+    if (face == -1) return;
+    setNeighbor(face, indexOf(face, oldNeighbor), newNeighbor);
+}
+
+void FlatMesh::updateObtuse(int face) {
+    unsigned char obtuse = isObtuseFace(points[vertex(face, 0)], points[vertex(face, 1)], points[vertex(face, 2)]);
+    obtuseCount += obtuse - faceObtuse[face];
+    faceObtuse[face] = obtuse;
+}
+
+void FlatMesh::beginTrial() {
+    recording = true;
+    journal.clear();
+    savedVertices = points.size();
+    savedFaces = numberOfFaces();
+    savedObtuseCount = obtuseCount;
+    movedPoints.clear();
+}
+
+void FlatMesh::rollback() {
+    for (auto it = journal.rbegin(); it != journal.rend(); ++it) {
+        for (int i = 0; i < 3; ++i) {
+            faceVertices[3 * it->face + i] = it->vertices[i];
+            faceNeighbors[3 * it->face + i] = it->neighbors[i];
+        }
+        faceConstraints[it->face] = it->constraints;
+        faceObtuse[it->face] = it->obtuse;
+    }
+
+    for (auto it = movedPoints.rbegin(); it != movedPoints.rend(); ++it) {
+        points[it->first] = it->second;
+    }
+
+    points.resize(savedVertices);
+    steinerIndices.resize(savedVertices);
+    faceVertices.resize(3 * savedFaces);
+    faceNeighbors.resize(3 * savedFaces);
+    faceConstraints.resize(savedFaces);
+    faceObtuse.resize(savedFaces);
+    obtuseCount = savedObtuseCount;
+
+    journal.clear();
+    movedPoints.clear();
+    recording = false;
+}
+
+void FlatMesh::commit() {
+    journal.clear();
+    movedPoints.clear();
+    recording = false;
+}
+
+void FlatMesh::materializePoints() {
+    for (auto& p : points) {
+        p = TriangulationUtils::exactPoint(p);
+    }
+}
@@ -1,19 +1,23 @@
 #include "triangulation.hpp"
 #include "jsonUtils.hpp"
+#include "solutionFormat.hpp"
 
 using json = nlohmann::json;
 
 InputData JsonUtils::parseInputJson(const std::string& filename) {
-    InputData input_data;
     std::ifstream input_file(filename);
     json input_json;
     input_file >> input_json;
+    return parseInput(input_json);
+}
 
-    input_data.instance_uid = input_json["instance_uid"];
-    input_data.num_points = input_json["num_points"];
+InputData JsonUtils::parseInput(const json& input_json) {
+    InputData input_data;
+    input_data.instance_uid = input_json.at("instance_uid");
+    input_data.num_points = input_json.at("num_points");
 
-    auto points_x_json = input_json["points_x"];
-    auto points_y_json = input_json["points_y"];
+    auto points_x_json = input_json.at("points_x");
+    auto points_y_json = input_json.at("points_y");
 
     for (const auto& x_val : points_x_json) {
         input_data.points_x.push_back(FT(x_val.get<int>()));
@@ -23,9 +27,9 @@ InputData JsonUtils::parseInputJson(const std::string& filename) {
         input_data.points_y.push_back(FT(y_val.get<int>()));
     }
 
-    input_data.region_boundary = input_json["region_boundary"].get<std::vector<int>>();
-    input_data.num_constraints = input_json["num_constraints"];
-    input_data.additional_constraints = input_json["additional_constraints"].get<std::vector<std::vector<int>>>();
+    input_data.region_boundary = input_json.at("region_boundary").get<std::vector<int>>();
+    input_data.num_constraints = input_json.at("num_constraints");
+    input_data.additional_constraints = input_json.at("additional_constraints").get<std::vector<std::vector<int>>>();
 
     // if (input_json.contains("method")) {
     //         input_data.method = input_json["method"].get<std::string>();
@@ -40,6 +44,12 @@ InputData JsonUtils::parseInputJson(const std::string& filename) {
 
     input_data.parameters = input_json.value("parameters", json::object()); // Default: empty object
 
+    readParameters(input_data);
+
+    return input_data;
+}
+
+void JsonUtils::readParameters(InputData& input_data) {
     //if (input_data.method == "ls") {
         input_data.L = input_data.parameters.value("L", 500);  // Default: 500
     //} else if (input_data.method == "sa") {
@@ -56,12 +66,23 @@ InputData JsonUtils::parseInputJson(const std::string& filename) {
         //input_data.L = input_data.parameters.value("L", 0);
     //}
 
-    
-
-    return input_data;
+    input_data.time_limit = input_data.parameters.value("time_limit", 0.0);
+    input_data.seed = input_data.parameters.value("seed", std::random_device{}());
+    input_data.prune = input_data.parameters.value("prune", false);
+    input_data.snap_denominator = input_data.parameters.value("snap_denominator", 0L);
+    input_data.snap_grid = input_data.parameters.value("snap_grid", false);
+    input_data.materialize_every = input_data.parameters.value("materialize_every", 0);
+    input_data.target_ratio = input_data.parameters.value("target_ratio", -1.0);
+    input_data.stats = input_data.parameters.value("stats", false);
+    input_data.stats_samples = input_data.parameters.value("stats_samples", 64);
 }
 
 void JsonUtils::writeOutputJson(const std::string& filename, const OutputData& output_data) {
+    std::ofstream output_file(filename);
+    output_file << toJson(output_data).dump(4);
+}
+
+json JsonUtils::toJson(const OutputData& output_data) {
     json output_json;
     output_json["content_type"] = output_data.content_type;
     output_json["instance_uid"] = output_data.instance_uid;
@@ -72,7 +93,41 @@ void JsonUtils::writeOutputJson(const std::string& filename, const OutputData& o
     output_json["method"] = output_data.method;
     output_json["parameters"] = output_data.parameters;
     output_json["randomization"] = output_data.randomization_used;
+    if (!output_data.stats.is_null()) {
+        output_json["stats"] = output_data.stats;
+    }
+    return output_json;
+}
+FT JsonUtils::parseRational(const json& value) {
+    if (value.is_number_integer()) {
+        return FT(value.get<long>());
+    }
+    FT::ET rational(value.get<std::string>());
+    rational.canonicalize();
+    return FT(rational);
+}
 
-    std::ofstream output_file(filename);
-    output_file << output_json.dump(4);
-}
\ No newline at end of file
+std::vector<Point> JsonUtils::parseSolutionSteinerPoints(const std::string& filename) {
+    if (SolutionFormat::isBinary(filename)) {
+        return SolutionFormat::readSteinerPoints(filename);
+    }
+
+    std::ifstream solution_file(filename);
+    if (!solution_file) {
+        throw std::runtime_error("Cannot open solution file " + filename);
+    }
+    json solution_json;
+    solution_file >> solution_json;
+
+    auto steiner_x_json = solution_json.value("steiner_points_x", json::array());
+    auto steiner_y_json = solution_json.value("steiner_points_y", json::array());
+    if (steiner_x_json.size() != steiner_y_json.size()) {
+        throw std::runtime_error("Steiner coordinate lists differ in length in " + filename);
+    }
+
+    std::vector<Point> steiner_points;
+    for (size_t i = 0; i < steiner_x_json.size(); ++i) {
+        steiner_points.emplace_back(parseRational(steiner_x_json[i]), parseRational(steiner_y_json[i]));
+    }
+    return steiner_points;
+}
@@ -1,36 +1,22 @@
 #include <iostream>
 #include "midpointMethod.hpp"
 #include "triangulationUtils.hpp"
+#include "steinerMethods.hpp"
 
 MidpointMethod::MidpointMethod() {
 }
 
-void MidpointMethod::insertMidpoint(CDT& cdt, Face_handle face, std::vector<Point>& steiner_points) {
-
-    // Find midpoint
-    Point p1 = face->vertex(0)->point();
-    Point p2 = face->vertex(1)->point();
-    Point p3 = face->vertex(2)->point();
+bool MidpointMethod::steinerPoint(const CDT& cdt, Face_handle face, Point& point) {
+    // Midpoint of the longest edge
+    return MidpointPoint::point(cdt, face, point);
+}
 
-    // Find the longest edge
-    FT d1 = TriangulationUtils::squaredDistance(p1, p2);
-    FT d2 = TriangulationUtils::squaredDistance(p2, p3);
-    FT d3 = TriangulationUtils::squaredDistance(p3, p1);
+void MidpointMethod::insertMidpoint(CDT& cdt, Face_handle face, std::vector<Point>& steiner_points) {
 
+    // Midpoint of the longest edge
     Point midpoint;
-    if (d1 >= d2 && d1 >= d3) {
-        // Longest edge is between p1 and p2
-        midpoint = CGAL::midpoint(p1, p2);
-        cdt.insert(midpoint);
-    } else if (d2 >= d1 && d2 >= d3) {
-        // Longest edge is between p2 and p3
-        midpoint = CGAL::midpoint(p2, p3);
-        cdt.insert(midpoint);
-    } else {
-        // Longest edge is between p3 and p1
-        midpoint = CGAL::midpoint(p3, p1);
-        cdt.insert(midpoint);
-    }
+    steinerPoint(cdt, face, midpoint);
+    cdt.insert(midpoint);
     steiner_points.push_back(midpoint);
 
 }
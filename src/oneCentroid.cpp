@@ -1,19 +1,21 @@
 #include <iostream>
 #include "oneCentroid.hpp"
 #include "triangulationUtils.hpp"
+#include "steinerMethods.hpp"
 
 oneCentroidMethod::oneCentroidMethod() {
 }
 
+bool oneCentroidMethod::steinerPoint(const CDT& cdt, Face_handle face, Point& point) {
+    return CentroidPoint::point(cdt, face, point);
+}
+
 // Function to insert the centroid of an obtuse triangle into the triangulation
 void oneCentroidMethod::insertoneCentroid(CDT& cdt, Face_handle face, std::vector<Point>& steiner_points) {
 
     // Find centroid
-    Point p1 = face->vertex(0)->point();
-    Point p2 = face->vertex(1)->point();
-    Point p3 = face->vertex(2)->point();
-
-    Point centroid = TriangulationUtils::computeCentroid(p1, p2, p3);
+    Point centroid;
+    steinerPoint(cdt, face, centroid);
 
 
     // Insert centroid and update triangulation
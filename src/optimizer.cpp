@@ -0,0 +1,467 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include "optimizer.hpp"
+#include "algorithms.hpp"
+#include "triangulationUtils.hpp"
+#include "orthoConstruction.hpp"
+#include "tileDecomposition.hpp"
+
+// Fraction of the budget spent on the tiles, the rest is left for the seams
+#define TILE_SHARE 0.75
+// Seconds between the copies a portfolio lane publishes of its state
+#define PUBLISH_INTERVAL 1.0
+
+OptimizerResult Optimizer::makeResult(const CDT& cdt, const std::vector<Point>& steinerPoints, const SearchControl& control, double convergenceRate) const {
+    OptimizerResult result;
+    result.engine = this->name();
+    result.parameters = this->parameters();
+    result.convergence_rate = convergenceRate;
+    result.obtuse_count = TriangulationUtils::countObtuseTriangles(cdt);
+    result.steiner_count = steinerPoints.size();
+    result.iterations = control.getIterations();
+    result.energy = control.energy(result.obtuse_count, result.steiner_count);
+    result.elapsed = control.elapsed();
+    result.time_to_target = control.getTimeToTarget();
+    result.telemetry = control.getTelemetry();
+    if (!SearchControl::memoryUsage(result.rss_kb, result.peak_rss_kb)) {
+        result.rss_kb = result.peak_rss_kb = -1;
+    }
+    return result;
+}
+
+// LOCAL SEARCH
+
+LocalSearchOptimizer::LocalSearchOptimizer(const InputData& input_data) : L(input_data.L), round(0) {
+}
+
+nlohmann::json LocalSearchOptimizer::parameters() const {
+    return { L };
+}
+
+OptimizerResult LocalSearchOptimizer::run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) {
+    double convergenceRate = local_search(cdt, steinerPoints, L, control, round);
+    return makeResult(cdt, steinerPoints, control, convergenceRate);
+}
+
+nlohmann::json LocalSearchOptimizer::state() const {
+    return { { "round", round } };
+}
+
+void LocalSearchOptimizer::restore(const nlohmann::json& parameters, const nlohmann::json& state) {
+    L = parameters.at(0);
+    round = state.at("round");
+}
+
+// SA
+
+SimulatedAnnealingOptimizer::SimulatedAnnealingOptimizer(const InputData& input_data)
+    : alpha(input_data.alpha), beta(input_data.beta), L(input_data.parameters.value("L", 750)), temperature(1.0) {
+}
+
+nlohmann::json SimulatedAnnealingOptimizer::parameters() const {
+    return { alpha, beta, L };
+}
+
+OptimizerResult SimulatedAnnealingOptimizer::run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) {
+    double convergenceRate = simulated_annealing(cdt, steinerPoints, alpha, beta, L, control, temperature);
+    return makeResult(cdt, steinerPoints, control, convergenceRate);
+}
+
+nlohmann::json SimulatedAnnealingOptimizer::state() const {
+    return { { "temperature", temperature } };
+}
+
+void SimulatedAnnealingOptimizer::restore(const nlohmann::json& parameters, const nlohmann::json& state) {
+    alpha = parameters.at(0);
+    beta = parameters.at(1);
+    L = parameters.at(2);
+    temperature = state.at("temperature");
+}
+
+// Ant Colonies
+
+AntColonyOptimizer::AntColonyOptimizer(const InputData& input_data)
+    : alpha(input_data.alpha), beta(input_data.beta), xi(input_data.xi), psi(input_data.psi),
+      lambda(input_data.lambda), kappa(input_data.kappa), L(input_data.L), cycle(0) {
+}
+
+nlohmann::json AntColonyOptimizer::parameters() const {
+    return { alpha, beta, xi, psi, lambda, kappa, L };
+}
+
+OptimizerResult AntColonyOptimizer::run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) {
+    double convergenceRate = ant_colonies(cdt, steinerPoints, alpha, beta, xi, psi, lambda, kappa, L, control, cycle, pheromones);
+    return makeResult(cdt, steinerPoints, control, convergenceRate);
+}
+
+nlohmann::json AntColonyOptimizer::state() const {
+    return { { "cycle", cycle }, { "pheromones", pheromones } };
+}
+
+void AntColonyOptimizer::restore(const nlohmann::json& parameters, const nlohmann::json& state) {
+    alpha = parameters.at(0);
+    beta = parameters.at(1);
+    xi = parameters.at(2);
+    psi = parameters.at(3);
+    lambda = parameters.at(4);
+    kappa = parameters.at(5);
+    L = parameters.at(6);
+    cycle = state.at("cycle");
+    pheromones = state.at("pheromones").get<std::vector<double>>();
+}
+
+// Beam search
+
+BeamSearchOptimizer::BeamSearchOptimizer(const InputData& input_data)
+    : width(input_data.parameters.value("beam_width", 8)), depth(input_data.parameters.value("beam_depth", 5)) {
+}
+
+nlohmann::json BeamSearchOptimizer::parameters() const {
+    return { width, depth };
+}
+
+OptimizerResult BeamSearchOptimizer::run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) {
+    double convergenceRate = beam_search(cdt, steinerPoints, width, depth, control);
+    return makeResult(cdt, steinerPoints, control, convergenceRate);
+}
+
+// Edge flips
+
+FlipOptimizer::FlipOptimizer(const InputData& input_data) {
+}
+
+nlohmann::json FlipOptimizer::parameters() const {
+    return nlohmann::json::array();
+}
+
+OptimizerResult FlipOptimizer::run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) {
+    control.begin(TriangulationUtils::countObtuseTriangles(cdt), steinerPoints.size());
+    int flips = flip_edges(cdt);
+    control.report(TriangulationUtils::countObtuseTriangles(cdt), steinerPoints.size());
+    control.log("Edge flips: ", flips);
+    return makeResult(cdt, steinerPoints, control, 0.0);
+}
+
+// Ortho
+
+OrthoOptimizer::OrthoOptimizer(const InputData& input_data)
+    : input_data(input_data), then(input_data.parameters.value("then", "ls")) {
+    for (int index : input_data.region_boundary) {
+        boundary.emplace_back(input_data.points_x[index], input_data.points_y[index]);
+    }
+}
+
+nlohmann::json OrthoOptimizer::parameters() const {
+    return { then };
+}
+
+OptimizerResult OrthoOptimizer::run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) {
+    control.begin(TriangulationUtils::countObtuseTriangles(cdt), steinerPoints.size());
+
+    int added = OrthoConstruction::construct(cdt, boundary, steinerPoints);
+    int obtuse = TriangulationUtils::countObtuseTriangles(cdt);
+    control.report(obtuse, steinerPoints.size());
+    control.log("Ortho construction Steiner points: ", added, ", obtuse triangles: ", obtuse);
+
+    if (obtuse == 0 || then == "none" || then == name() || !OptimizerRegistry::contains(then)) {
+        return makeResult(cdt, steinerPoints, control, 0.0);
+    }
+
+    // The rest of the budget goes to the engine that continues from the construction
+    auto optimizer = OptimizerRegistry::create(then, input_data);
+    OptimizerResult result = optimizer->run(cdt, steinerPoints, control);
+    result.engine = name();
+    result.parameters = parameters();
+    result.elapsed = control.elapsed();
+    return result;
+}
+
+// Portfolio
+
+PortfolioOptimizer::PortfolioOptimizer(const InputData& input_data)
+    : input_data(input_data), engines({ "ls", "sa", "ant" }) {
+}
+
+nlohmann::json PortfolioOptimizer::parameters() const {
+    return engines;
+}
+
+OptimizerResult PortfolioOptimizer::run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) {
+    struct Lane {
+        std::unique_ptr<Optimizer> optimizer;
+        CDT cdt;
+        std::vector<Point> steinerPoints;
+        OptimizerResult result;
+        bool finished = false;
+    };
+
+    // Exact copy of the points of the best lane so far, forwarded to the outer control
+    struct Published {
+        std::mutex mutex;
+        double energy = std::numeric_limits<double>::infinity();
+        int obtuseCount = 0;
+        std::vector<Point> steinerPoints;
+        bool fresh = false;
+    };
+
+    control.begin(TriangulationUtils::countObtuseTriangles(cdt), steinerPoints.size());
+
+    SharedIncumbent incumbent;
+    Published published;
+    std::atomic<int> running(engines.size());
+    std::vector<Lane> lanes(engines.size());
+    std::vector<std::thread> threads;
+
+    // Every engine gets the whole remaining budget, the shared incumbent cuts the losers short
+    double timeLimit = control.remaining();
+
+    // The copies share the lazy exact values of the points, every lane gets its own before the threads start
+    for (size_t i = 0; i < engines.size(); ++i) {
+        lanes[i].optimizer = OptimizerRegistry::create(engines[i], input_data);
+        lanes[i].cdt = cdt;
+        lanes[i].steinerPoints = steinerPoints;
+        materialize_points(lanes[i].cdt, lanes[i].steinerPoints);
+    }
+
+    for (size_t i = 0; i < lanes.size(); ++i) {
+        unsigned int seed = control.getRng()();
+        threads.emplace_back([&lanes, &incumbent, &published, &running, &control, timeLimit, seed, i]() {
+            Lane& lane = lanes[i];
+            SearchControl laneControl(timeLimit, seed, control.getA(), control.getB(), &incumbent);
+            laneControl.setSnapping(control.getSnapDenominator(), control.getSnapGrid());
+            laneControl.setMaterializeInterval(control.getMaterializeInterval());
+            laneControl.setCancellation(control.getCancellation());
+            laneControl.setLog(control.getLog());
+            laneControl.setTarget(control.getTargetRatio());
+            laneControl.setTelemetry(control.getTelemetryCapacity());
+            laneControl.setProgress([&lane, &published](const SearchControl& state) {
+                std::lock_guard<std::mutex> lock(published.mutex);
+                if (state.getCurrentEnergy() >= published.energy) return;
+                published.energy = state.getCurrentEnergy();
+                published.obtuseCount = state.getObtuseCount();
+                published.steinerPoints.clear();
+                for (const auto& p : lane.steinerPoints) {
+                    published.steinerPoints.push_back(TriangulationUtils::exactPoint(p));
+                }
+                published.fresh = true;
+            }, PUBLISH_INTERVAL);
+            try {
+                lane.result = lane.optimizer->run(lane.cdt, lane.steinerPoints, laneControl);
+                lane.finished = true;
+            } catch (const std::exception& e) {
+                laneControl.log("Engine ", lane.optimizer->name(), " failed: ", e.what());
+            }
+            running--;
+        });
+    }
+
+    // Checkpoints and progress of the outer control follow the best lane
+    while (running > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::unique_lock<std::mutex> lock(published.mutex);
+        if (!published.fresh) continue;
+        published.fresh = false;
+        steinerPoints = published.steinerPoints;
+        int obtuseCount = published.obtuseCount;
+        lock.unlock();
+        control.report(obtuseCount, steinerPoints.size());
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    Lane* best = nullptr;
+    for (auto& lane : lanes) {
+        if (!lane.finished) continue;
+        control.log(lane.result.engine, " obtuse triangles: ", lane.result.obtuse_count,
+                    ", steiner points: ", lane.result.steiner_count);
+        if (best == nullptr || lane.result.energy < best->result.energy) {
+            best = &lane;
+        }
+    }
+
+    if (best == nullptr) {
+        throw std::runtime_error("No engine of the portfolio finished");
+    }
+
+    cdt = best->cdt;
+    steinerPoints = best->steinerPoints;
+    control.report(best->result.obtuse_count, steinerPoints.size());
+
+    OptimizerResult result = best->result;
+    result.elapsed = control.elapsed();
+    return result;
+}
+
+// Tiles
+
+TiledOptimizer::TiledOptimizer(const InputData& input_data)
+    : input_data(input_data),
+      tileSize(input_data.parameters.value("tile_size", 4000)),
+      engine(input_data.parameters.value("tile_engine", "ls")) {
+    if (engine == name() || !OptimizerRegistry::contains(engine)) {
+        engine = "ls";
+    }
+}
+
+nlohmann::json TiledOptimizer::parameters() const {
+    return { tileSize, engine };
+}
+
+OptimizerResult TiledOptimizer::run(CDT& cdt, std::vector<Point>& steinerPoints, SearchControl& control) {
+    control.begin(TriangulationUtils::countObtuseTriangles(cdt), steinerPoints.size());
+
+    std::map<Face_handle, int> tileOf;
+    auto tiles = decompose(cdt, tileOf);
+
+    // Only tiles with obtuse triangles are worth optimizing
+    std::vector<int> work;
+    for (size_t i = 0; i < tiles.size(); ++i) {
+        if (tiles[i].obtuseCount > 0) work.push_back(i);
+    }
+
+    // A single tile that covers every face is the whole problem, the engine gets it directly
+    if (!work.empty() && (tiles.size() > 1 || static_cast<int>(tileOf.size()) < cdt.number_of_faces())) {
+        struct Task {
+            CDT cdt;
+            std::vector<Point> steinerPoints;
+            std::unique_ptr<Optimizer> optimizer;
+            unsigned int seed;
+        };
+
+        // The CDT is only read by the workers, the tiles are extracted up front
+        std::vector<Task> tasks(work.size());
+        for (size_t i = 0; i < work.size(); ++i) {
+            tasks[i].cdt = TileDecomposition::extractTile(cdt, tiles, work[i], tileOf);
+            tasks[i].optimizer = OptimizerRegistry::create(engine, input_data);
+            tasks[i].seed = control.getRng()();
+        }
+
+        size_t workers = std::max(1u, std::thread::hardware_concurrency());
+        workers = std::min(workers, tasks.size());
+        double tileBudget = TILE_SHARE * control.remaining() * workers / tasks.size();
+
+        std::atomic<size_t> next(0);
+        std::vector<std::thread> threads;
+        for (size_t w = 0; w < workers; ++w) {
+            threads.emplace_back([&tasks, &next, &control, tileBudget]() {
+                for (size_t i = next++; i < tasks.size() && !control.shouldStop(); i = next++) {
+                    Task& task = tasks[i];
+                    SearchControl tileControl(tileBudget, task.seed, control.getA(), control.getB());
+                    tileControl.setSnapping(control.getSnapDenominator(), control.getSnapGrid());
+                    tileControl.setMaterializeInterval(control.getMaterializeInterval());
+                    tileControl.setCancellation(control.getCancellation());
+                    tileControl.setLog(control.getLog());
+                    try {
+                        task.optimizer->run(task.cdt, task.steinerPoints, tileControl);
+                    } catch (const std::exception& e) {
+                        tileControl.log("Tile engine ", task.optimizer->name(), " failed: ", e.what());
+                        task.steinerPoints.clear();
+                    }
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        // Points that fell outside their tile would change a neighbour the tile did not see
+        std::vector<Point> stitched;
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            for (const auto& p : tasks[i].steinerPoints) {
+                if (TileDecomposition::owns(cdt, work[i], tileOf, p)) {
+                    stitched.push_back(p);
+                }
+            }
+        }
+
+        cdt.insert(stitched.begin(), stitched.end());
+        steinerPoints.insert(steinerPoints.end(), stitched.begin(), stitched.end());
+        int obtuse = TriangulationUtils::countObtuseTriangles(cdt);
+        control.report(obtuse, steinerPoints.size());
+        control.log("Tiles: ", tiles.size(), ", optimized: ", tasks.size(), ", Steiner points: ", stitched.size(),
+                    ", obtuse triangles after stitching: ", obtuse);
+    }
+
+    if (TriangulationUtils::countObtuseTriangles(cdt) == 0 || control.shouldStop()) {
+        return makeResult(cdt, steinerPoints, control, 0.0);
+    }
+
+    // The seams, or the whole instance if it fits in one tile, get the rest of the budget
+    auto optimizer = OptimizerRegistry::create(engine, input_data);
+    OptimizerResult result = optimizer->run(cdt, steinerPoints, control);
+    result.engine = name();
+    result.parameters = parameters();
+    result.elapsed = control.elapsed();
+    return result;
+}
+
+std::vector<TileDecomposition::Tile> TiledOptimizer::decompose(const CDT& cdt, std::map<Face_handle, int>& tileOf) const {
+    return TileDecomposition::partition(cdt, tileSize, tileOf);
+}
+
+// Clusters
+
+ClusterOptimizer::ClusterOptimizer(const InputData& input_data)
+    : TiledOptimizer(input_data), halo(std::max(0, input_data.parameters.value("cluster_halo", 2))) {
+    if (engine == name() || engine == TiledOptimizer::name()) {
+        engine = "ls";
+    }
+}
+
+nlohmann::json ClusterOptimizer::parameters() const {
+    return { tileSize, engine, halo };
+}
+
+std::vector<TileDecomposition::Tile> ClusterOptimizer::decompose(const CDT& cdt, std::map<Face_handle, int>& tileOf) const {
+    return TileDecomposition::clusters(cdt, halo, tileSize, tileOf);
+}
+
+// Registry
+
+std::map<std::string, OptimizerRegistry::Factory>& OptimizerRegistry::factories() {
+    // Built-in engines are registered on first use so that the registry also works from a static library
+    static std::map<std::string, Factory> registry = {
+        { "ls", [](const InputData& input_data) { return std::unique_ptr<Optimizer>(new LocalSearchOptimizer(input_data)); } },
+        { "sa", [](const InputData& input_data) { return std::unique_ptr<Optimizer>(new SimulatedAnnealingOptimizer(input_data)); } },
+        { "ant", [](const InputData& input_data) { return std::unique_ptr<Optimizer>(new AntColonyOptimizer(input_data)); } },
+        { "beam", [](const InputData& input_data) { return std::unique_ptr<Optimizer>(new BeamSearchOptimizer(input_data)); } },
+        { "flip", [](const InputData& input_data) { return std::unique_ptr<Optimizer>(new FlipOptimizer(input_data)); } },
+        { "ortho", [](const InputData& input_data) { return std::unique_ptr<Optimizer>(new OrthoOptimizer(input_data)); } },
+        { "portfolio", [](const InputData& input_data) { return std::unique_ptr<Optimizer>(new PortfolioOptimizer(input_data)); } },
+        { "tiles", [](const InputData& input_data) { return std::unique_ptr<Optimizer>(new TiledOptimizer(input_data)); } },
+        { "clusters", [](const InputData& input_data) { return std::unique_ptr<Optimizer>(new ClusterOptimizer(input_data)); } },
+    };
+    return registry;
+}
+
+void OptimizerRegistry::registerOptimizer(const std::string& name, Factory factory) {
+    factories()[name] = factory;
+}
+
+bool OptimizerRegistry::contains(const std::string& name) {
+    return factories().count(name) > 0;
+}
+
+std::unique_ptr<Optimizer> OptimizerRegistry::create(const std::string& name, const InputData& input_data) {
+    auto it = factories().find(name);
+    if (it == factories().end()) {
+        throw std::invalid_argument("Unknown optimizer: " + name);
+    }
+    return it->second(input_data);
+}
+
+std::vector<std::string> OptimizerRegistry::names() {
+    std::vector<std::string> result;
+    for (const auto& entry : factories()) {
+        result.push_back(entry.first);
+    }
+    return result;
+}
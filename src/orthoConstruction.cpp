@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <set>
+#include "orthoConstruction.hpp"
+#include "triangulationUtils.hpp"
+
+// Largest grid the construction classifies, about 2000 by 2000 coordinates
+#define ORTHO_MAX_CELLS 4000000
+
+bool OrthoConstruction::isApplicable(const std::vector<Point>& boundary) {
+    return boundary.size() >= 4 && TriangulationUtils::isAxisParallel(boundary);
+}
+
+std::vector<FT> OrthoConstruction::distinctCoordinates(const CDT& cdt, bool x) {
+    std::vector<FT> values;
+    for (auto vit = cdt.finite_vertices_begin(); vit != cdt.finite_vertices_end(); ++vit) {
+        values.push_back(x ? vit->point().x() : vit->point().y());
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+void OrthoConstruction::collectChords(const CDT& cdt, const std::vector<FT>& xs, const std::vector<FT>& ys,
+                                      const std::vector<std::vector<bool>>& inside, bool vertical,
+                                      std::vector<Chord>& chords, std::vector<std::vector<bool>>& nodes) {
+    // Grid lines that carry an input point
+    std::set<Point> points;
+    std::set<FT> carried;
+    for (auto vit = cdt.finite_vertices_begin(); vit != cdt.finite_vertices_end(); ++vit) {
+        points.insert(vit->point());
+        carried.insert(vertical ? vit->point().x() : vit->point().y());
+    }
+
+    const std::vector<FT>& across = vertical ? xs : ys;
+    const std::vector<FT>& along = vertical ? ys : xs;
+
+    for (size_t line = 0; line < across.size(); ++line) {
+        if (!carried.count(across[line])) continue;
+
+        auto point = [&](size_t k) { return vertical ? Point(across[line], along[k]) : Point(along[k], across[line]); };
+        // The grid edge between nodes k and k + 1 lies in the domain if a cell on either side does
+        auto edgeInside = [&](size_t k) {
+            bool before = line > 0 && (vertical ? inside[line - 1][k] : inside[k][line - 1]);
+            bool after = line + 1 < across.size() && (vertical ? inside[line][k] : inside[k][line]);
+            return before || after;
+        };
+
+        size_t k = 0;
+        while (k + 1 < along.size()) {
+            if (!edgeInside(k)) {
+                k++;
+                continue;
+            }
+            size_t start = k;
+            while (k + 1 < along.size() && edgeInside(k)) k++;
+
+            // Keep the run only if one of the input points lies on it
+            bool used = false;
+            for (size_t j = start; j <= k && !used; ++j) {
+                used = points.count(point(j)) > 0;
+            }
+            if (!used) continue;
+
+            chords.push_back({ point(start), point(k) });
+            for (size_t j = start; j <= k; ++j) {
+                if (vertical) nodes[line][j] = true; else nodes[j][line] = true;
+            }
+        }
+    }
+}
+
+int OrthoConstruction::construct(CDT& cdt, const std::vector<Point>& boundary, std::vector<Point>& steinerPoints) {
+    if (!isApplicable(boundary)) return 0;
+
+    std::vector<FT> xs = distinctCoordinates(cdt, true);
+    std::vector<FT> ys = distinctCoordinates(cdt, false);
+    if (xs.size() < 2 || ys.size() < 2) return 0;
+
+    // The grid has a cell per pair of coordinates, larger ones are left to the engine that follows
+    if ((xs.size() - 1) * (ys.size() - 1) > ORTHO_MAX_CELLS) return 0;
+
+    // Cells of the grid through all input coordinates, classified column by column: the horizontal
+    // boundary edges that span a column cut it into intervals that are alternately outside and inside
+    std::vector<std::vector<bool>> inside(xs.size() - 1, std::vector<bool>(ys.size() - 1));
+    for (size_t i = 0; i + 1 < xs.size(); ++i) {
+        FT centre = (xs[i] + xs[i + 1]) / 2;
+        std::vector<FT> crossings;
+        for (size_t k = 0; k < boundary.size(); ++k) {
+            const Point& a = boundary[k];
+            const Point& b = boundary[(k + 1) % boundary.size()];
+            if (a.y() == b.y() && (a.x() < centre) != (b.x() < centre)) crossings.push_back(a.y());
+        }
+        std::sort(crossings.begin(), crossings.end());
+
+        size_t below = 0;
+        for (size_t j = 0; j + 1 < ys.size(); ++j) {
+            FT middle = (ys[j] + ys[j + 1]) / 2;
+            while (below < crossings.size() && crossings[below] < middle) below++;
+            inside[i][j] = below % 2 == 1;
+        }
+    }
+
+    // A node is a vertex of the decomposition if a vertical and a horizontal chord meet there
+    std::vector<Chord> verticalChords, horizontalChords;
+    std::vector<std::vector<bool>> verticalNodes(xs.size(), std::vector<bool>(ys.size()));
+    std::vector<std::vector<bool>> horizontalNodes(xs.size(), std::vector<bool>(ys.size()));
+    collectChords(cdt, xs, ys, inside, true, verticalChords, verticalNodes);
+    collectChords(cdt, xs, ys, inside, false, horizontalChords, horizontalNodes);
+
+    int added = 0;
+    Face_handle hint;
+    for (size_t i = 0; i < xs.size(); ++i) {
+        for (size_t j = 0; j < ys.size(); ++j) {
+            if (!verticalNodes[i][j] || !horizontalNodes[i][j]) continue;
+            Point p(xs[i], ys[j]);
+            CDT::Locate_type type;
+            int index;
+            hint = cdt.locate(p, type, index, hint);
+            if (type == CDT::VERTEX) continue;
+            hint = cdt.insert(p, type, hint, index)->face();
+            steinerPoints.push_back(p);
+            added++;
+        }
+    }
+
+    // The chords end on nodes or input points, so constraining them below adds no vertex that is
+    // missing from steinerPoints
+    std::set<std::pair<Point, Point>> constrained;
+    for (auto eit = cdt.finite_edges_begin(); eit != cdt.finite_edges_end(); ++eit) {
+        if (!cdt.is_constrained(*eit)) continue;
+        Point a = eit->first->vertex(cdt.ccw(eit->second))->point();
+        Point b = eit->first->vertex(cdt.cw(eit->second))->point();
+        constrained.insert(std::minmax(a, b));
+    }
+
+    // Chords as constraints so that no triangle crosses a rectangle side; a rectangle with chord
+    // ends on its sides (T-junctions) is fanned from them and gets non-right triangles
+    for (const auto& chord : verticalChords) cdt.insert_constraint(chord.source, chord.target);
+    for (const auto& chord : horizontalChords) cdt.insert_constraint(chord.source, chord.target);
+
+    // The chords only shape the construction; left constrained they would stop the engines that run
+    // next from flipping them and be reported as part of the domain. Removing the constraints flips
+    // only the edges that are no longer Delaunay, the right triangles of the rectangles stay
+    std::vector<std::pair<Vertex_handle, Vertex_handle>> chordEdges;
+    for (auto eit = cdt.finite_edges_begin(); eit != cdt.finite_edges_end(); ++eit) {
+        if (!cdt.is_constrained(*eit)) continue;
+        Vertex_handle a = eit->first->vertex(cdt.ccw(eit->second));
+        Vertex_handle b = eit->first->vertex(cdt.cw(eit->second));
+        if (!constrained.count(std::minmax(a->point(), b->point()))) chordEdges.emplace_back(a, b);
+    }
+    for (const auto& edge : chordEdges) {
+        Face_handle face;
+        int index;
+        if (cdt.is_edge(edge.first, edge.second, face, index) && face->is_constrained(index)) {
+            cdt.remove_constrained_edge(face, index);
+        }
+    }
+
+    return added;
+}
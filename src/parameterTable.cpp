@@ -0,0 +1,52 @@
+#include <fstream>
+#include <stdexcept>
+#include "parameterTable.hpp"
+#include "jsonUtils.hpp"
+#include "solver.hpp"
+#include "triangulationUtils.hpp"
+
+nlohmann::json ParameterTable::load(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        throw std::runtime_error("Cannot open parameter table " + filename);
+    }
+    nlohmann::json table;
+    file >> table;
+    if (!table.is_object()) {
+        throw std::runtime_error("Parameter table " + filename + " is not an object");
+    }
+    return table;
+}
+
+void ParameterTable::write(const std::string& filename, const nlohmann::json& table) {
+    std::ofstream file(filename);
+    file << table.dump(4) << std::endl;
+}
+
+std::string ParameterTable::category(const InputData& input_data) {
+    std::vector<std::pair<Point, Point>> constraints;
+    for (const auto& constraint : input_data.additional_constraints) {
+        Point p1(input_data.points_x[constraint[0]], input_data.points_y[constraint[0]]);
+        Point p2(input_data.points_x[constraint[1]], input_data.points_y[constraint[1]]);
+        constraints.emplace_back(p1, p2);
+    }
+    return TriangulationUtils::getCategory(constructBoundary(input_data), constraints);
+}
+
+bool ParameterTable::apply(const nlohmann::json& table, const std::string& engine, InputData& input_data) {
+    auto entry = table.find(category(input_data));
+    if (entry == table.end() || !entry->contains(engine)) return false;
+
+    // Explicit parameters of the input win over the tuned ones, an unseeded run keeps its seed
+    unsigned int seed = input_data.seed;
+    for (const auto& item : (*entry)[engine].items()) {
+        if (!input_data.parameters.contains(item.key())) {
+            input_data.parameters[item.key()] = item.value();
+        }
+    }
+    JsonUtils::readParameters(input_data);
+    if (!input_data.parameters.contains("seed")) {
+        input_data.seed = seed;
+    }
+    return true;
+}
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "parameterTuner.hpp"
+#include "parameterTable.hpp"
+#include "jsonUtils.hpp"
+#include "solver.hpp"
+
+ParameterTuner::ParameterTuner(const TuningOptions& options) : options(options), spent(0.0), reserved(0.0) {
+}
+
+const std::vector<TunedParameter>& ParameterTuner::space(const std::string& engine) {
+    // Defaults as in JsonUtils::readParameters and the engine constructors
+    static const std::map<std::string, std::vector<TunedParameter>> spaces = {
+        { "ls", { { "L", 100, 2000, true, true, 500 } } },
+        { "sa", { { "alpha", 1, 10, false, false, 5 },
+                  { "beta", 0.2, 5, false, true, 1 },
+                  { "L", 100, 3000, true, true, 750 } } },
+        { "ant", { { "alpha", 1, 10, false, false, 5 },
+                   { "beta", 0.2, 5, false, true, 1 },
+                   { "xi", 0.5, 3, false, false, 1 },
+                   { "psi", 0.5, 4, false, false, 2 },
+                   { "lambda", 0.1, 0.9, false, false, 0.5 },
+                   { "kappa", 2, 30, true, false, 10 },
+                   { "L", 100, 2000, true, true, 500 } } },
+        { "beam", { { "beam_width", 2, 32, true, true, 8 },
+                    { "beam_depth", 2, 10, true, false, 5 } } },
+    };
+    static const std::vector<TunedParameter> none;
+
+    auto it = spaces.find(engine);
+    return it == spaces.end() ? none : it->second;
+}
+
+nlohmann::json ParameterTuner::sample(const std::string& engine, bool defaults, std::mt19937& rng) const {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    nlohmann::json parameters = nlohmann::json::object();
+    for (const auto& parameter : space(engine)) {
+        double value = parameter.defaultValue;
+        if (!defaults) {
+            double u = uniform(rng);
+            value = parameter.logScale
+                ? std::exp(std::log(parameter.low) + u * (std::log(parameter.high) - std::log(parameter.low)))
+                : parameter.low + u * (parameter.high - parameter.low);
+        }
+        if (parameter.integer) {
+            parameters[parameter.name] = static_cast<int>(std::lround(value));
+        } else {
+            parameters[parameter.name] = std::round(value * 1000.0) / 1000.0;
+        }
+    }
+    return parameters;
+}
+
+double ParameterTuner::evaluate(const InputData& instance, const std::string& engine, const nlohmann::json& parameters, unsigned int seed) const {
+    InputData input_data = instance;
+    input_data.method = engine;
+    input_data.parameters = parameters;
+    input_data.parameters["time_limit"] = options.run_time;
+    input_data.parameters["seed"] = seed;
+    JsonUtils::readParameters(input_data);
+
+    OutputData output_data;
+    try {
+        perform_triangulation(input_data, output_data, RunOptions());
+    } catch (const std::exception& e) {
+        std::cerr << "Run of " << engine << " on " << instance.instance_uid << " failed: " << e.what() << std::endl;
+        return std::numeric_limits<double>::max();
+    }
+    return options.a * output_data.obtuse_triangle_count + options.b * output_data.steiner_points_x.size();
+}
+
+int ParameterTuner::best(const Race& race) const {
+    int winner = -1;
+    double winnerScore = std::numeric_limits<double>::infinity();
+    for (size_t c = 0; c < race.candidates.size(); ++c) {
+        if (!race.candidates[c].alive) continue;
+
+        double total = 0.0;
+        for (int stage = 0; stage < race.stage; ++stage) {
+            double lowest = std::numeric_limits<double>::max();
+            for (const auto& candidate : race.candidates) {
+                if (static_cast<int>(candidate.scores.size()) > stage) {
+                    lowest = std::min(lowest, candidate.scores[stage]);
+                }
+            }
+            total += race.candidates[c].scores[stage] / std::max(lowest, 1.0);
+        }
+        if (winner < 0 || total < winnerScore) {
+            winner = c;
+            winnerScore = total;
+        }
+    }
+    return winner;
+}
+
+double ParameterTuner::tCritical(int degrees) {
+    static const double quantiles[] = {
+        6.314, 2.920, 2.353, 2.132, 2.015, 1.943, 1.895, 1.860, 1.833, 1.812,
+        1.796, 1.782, 1.771, 1.761, 1.753, 1.746, 1.740, 1.734, 1.729, 1.725,
+        1.721, 1.717, 1.714, 1.711, 1.708, 1.706, 1.703, 1.701, 1.699, 1.697
+    };
+    if (degrees < 1) return std::numeric_limits<double>::infinity();
+    if (degrees <= 30) return quantiles[degrees - 1];
+    return 1.645;
+}
+
+void ParameterTuner::eliminate(Race& race) const {
+    int n = race.stage;
+    if (n < options.min_instances) return;
+
+    int winner = best(race);
+    const auto& reference = race.candidates[winner].scores;
+    for (size_t c = 0; c < race.candidates.size(); ++c) {
+        Candidate& candidate = race.candidates[c];
+        if (!candidate.alive || static_cast<int>(c) == winner) continue;
+
+        // Paired differences relative to the larger score so that every instance weighs the same
+        std::vector<double> differences;
+        for (int stage = 0; stage < n; ++stage) {
+            double worse = std::max({ candidate.scores[stage], reference[stage], 1.0 });
+            differences.push_back((candidate.scores[stage] - reference[stage]) / worse);
+        }
+        double mean = 0.0;
+        for (double d : differences) mean += d;
+        mean /= n;
+        double variance = 0.0;
+        for (double d : differences) variance += (d - mean) * (d - mean);
+        variance /= n - 1;
+
+        if (variance == 0.0) {
+            candidate.alive = mean <= 0.0;
+        } else {
+            candidate.alive = mean / std::sqrt(variance / n) <= tCritical(n - 1);
+        }
+    }
+}
+
+bool ParameterTuner::startStage(Race& race, std::deque<Run>& queue) {
+    int alive = 0;
+    for (const auto& candidate : race.candidates) {
+        if (candidate.alive) alive++;
+    }
+    if (race.stage >= static_cast<int>(race.instances.size()) || alive <= 1) return false;
+    if (spent + reserved + alive * options.run_time > options.cpu_budget) return false;
+
+    for (size_t c = 0; c < race.candidates.size(); ++c) {
+        if (race.candidates[c].alive) {
+            queue.push_back({ &race, static_cast<int>(c) });
+        }
+    }
+    race.pending = alive;
+    reserved += alive * options.run_time;
+    return true;
+}
+
+nlohmann::json ParameterTuner::tune(const std::vector<InputData>& instances) {
+    std::mt19937 rng(options.seed);
+
+    std::map<std::string, std::vector<const InputData*>> categories;
+    for (const auto& instance : instances) {
+        categories[ParameterTable::category(instance)].push_back(&instance);
+    }
+
+    // One race per category and engine, each on its own order of the instances
+    std::vector<std::unique_ptr<Race>> races;
+    for (const auto& category : categories) {
+        for (const auto& engine : options.engines) {
+            if (space(engine).empty()) {
+                std::cerr << "Engine " << engine << " has no tuned parameters, skipped" << std::endl;
+                continue;
+            }
+            std::unique_ptr<Race> race(new Race());
+            race->category = category.first;
+            race->engine = engine;
+            race->instances = category.second;
+            std::shuffle(race->instances.begin(), race->instances.end(), rng);
+            for (int c = 0; c < std::max(options.configurations, 1); ++c) {
+                Candidate candidate;
+                candidate.parameters = sample(engine, c == 0, rng);
+                race->candidates.push_back(candidate);
+            }
+            races.push_back(std::move(race));
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<Run> queue;
+    int running = 0;
+
+    for (auto& race : races) {
+        if (!startStage(*race, queue)) {
+            std::cerr << race->category << "/" << race->engine << ": no budget left, keeps the defaults" << std::endl;
+        }
+    }
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            changed.wait(lock, [&]() { return !queue.empty() || running == 0; });
+            // Nothing queued and nothing running: every race is over
+            if (queue.empty()) break;
+
+            Run run = queue.front();
+            queue.pop_front();
+            running++;
+            Race& race = *run.race;
+            const InputData& instance = *race.instances[race.stage];
+            nlohmann::json parameters = race.candidates[run.candidate].parameters;
+            unsigned int seed = options.seed + race.stage;
+            lock.unlock();
+
+            auto start = std::chrono::steady_clock::now();
+            double score = evaluate(instance, race.engine, parameters, seed);
+            std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+            lock.lock();
+            running--;
+            spent += seconds.count();
+            reserved -= options.run_time;
+            race.candidates[run.candidate].scores.push_back(score);
+
+            if (--race.pending == 0) {
+                race.stage++;
+                eliminate(race);
+                int alive = 0;
+                for (const auto& candidate : race.candidates) {
+                    if (candidate.alive) alive++;
+                }
+                std::cerr << race.category << "/" << race.engine << ": instance " << race.stage << " of " << race.instances.size()
+                          << ", candidates left " << alive << " of " << race.candidates.size()
+                          << ", CPU seconds " << spent << " of " << options.cpu_budget << std::endl;
+                startStage(race, queue);
+            }
+            changed.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < std::max(options.threads, 1); ++i) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    nlohmann::json table = nlohmann::json::object();
+    for (const auto& race : races) {
+        if (race->stage == 0) continue;
+        table[race->category][race->engine] = race->candidates[best(*race)].parameters;
+    }
+    return table;
+}
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include "resultCache.hpp"
+#include "engineVersion.hpp"
+
+namespace fs = std::filesystem;
+
+// 64-bit FNV-1a, two bases give a 128-bit key
+static std::uint64_t fnv1a(const std::string& data, std::uint64_t hash) {
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static std::string exactString(const FT& value) {
+    return CGAL::exact(value).get_str();
+}
+
+ResultCache::ResultCache(const std::string& directory, std::uintmax_t maxBytes)
+    : directory(directory), maxBytes(maxBytes) {
+    fs::create_directories(directory);
+}
+
+std::string ResultCache::key(const InputData& input_data) {
+    nlohmann::json content;
+    std::vector<std::string> points_x, points_y;
+    for (const auto& x : input_data.points_x) points_x.push_back(exactString(x));
+    for (const auto& y : input_data.points_y) points_y.push_back(exactString(y));
+    content["points_x"] = points_x;
+    content["points_y"] = points_y;
+    content["region_boundary"] = input_data.region_boundary;
+    content["additional_constraints"] = input_data.additional_constraints;
+
+    content["method"] = input_data.method;
+    content["delaunay"] = input_data.delaunay;
+    content["parameters"] = input_data.parameters;
+    content["resolved"] = { input_data.alpha, input_data.beta, input_data.xi, input_data.psi,
+                            input_data.lambda, input_data.kappa, input_data.L, input_data.time_limit, input_data.prune };
+    // Without an explicit seed any earlier run is as good as a new one
+    content["seed"] = input_data.parameters.contains("seed") ? nlohmann::json(input_data.seed) : nlohmann::json("random");
+    content["version"] = OPT_TRIANGULATION_VERSION;
+
+    std::string data = content.dump();
+    std::ostringstream key;
+    key << std::hex << std::setfill('0')
+        << std::setw(16) << fnv1a(data, 14695981039346656037ULL)
+        << std::setw(16) << fnv1a(data, 0x84222325cbf29ce4ULL);
+    return key.str();
+}
+
+std::string ResultCache::entryPath(const std::string& key) const {
+    return (fs::path(directory) / (key + ".output.json")).string();
+}
+
+bool ResultCache::lookup(const std::string& key, const std::string& outputFile) const {
+    std::error_code error;
+    fs::path entry = entryPath(key);
+    if (!fs::exists(entry, error)) return false;
+
+    fs::copy_file(entry, outputFile, fs::copy_options::overwrite_existing, error);
+    if (error) return false;
+
+    // Hits count as uses for the eviction order
+    fs::last_write_time(entry, fs::file_time_type::clock::now(), error);
+    return true;
+}
+
+void ResultCache::store(const std::string& key, const std::string& outputFile) {
+    std::error_code error;
+    fs::path entry = entryPath(key);
+    fs::path temporary = entry.string() + ".tmp";
+
+    // Copy and rename so that concurrent batch jobs never read half an entry
+    fs::copy_file(outputFile, temporary, fs::copy_options::overwrite_existing, error);
+    if (!error) fs::rename(temporary, entry, error);
+    if (error) {
+        std::cerr << "Cannot store result in cache: " << error.message() << std::endl;
+        return;
+    }
+    evict();
+}
+
+void ResultCache::evict() {
+    std::error_code error;
+    std::vector<std::pair<fs::file_time_type, fs::path>> entries;
+    std::uintmax_t total = 0;
+    for (const auto& file : fs::directory_iterator(directory, error)) {
+        if (file.path().extension() != ".json") continue;
+        total += file.file_size(error);
+        entries.emplace_back(file.last_write_time(error), file.path());
+    }
+    if (total <= maxBytes) return;
+
+    std::sort(entries.begin(), entries.end());
+    for (const auto& [time, path] : entries) {
+        if (total <= maxBytes) break;
+        std::uintmax_t size = fs::file_size(path, error);
+        if (fs::remove(path, error)) total -= size;
+    }
+}
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include "searchControl.hpp"
+#include "triangulationUtils.hpp"
+
+// After this fraction of the budget an engine that trails the incumbent is cut off
+#define LOSER_GRACE 0.5
+// Relative energy gap to the incumbent that marks an engine as a loser
+#define LOSER_MARGIN 0.1
+
+SearchControl::SearchControl(double timeLimit, unsigned int seed, double a, double b, SharedIncumbent* incumbent)
+    : startTime(std::chrono::steady_clock::now()),
+      timeLimit(timeLimit),
+      seed(seed),
+      a(a),
+      b(b),
+      rng(seed),
+      incumbent(incumbent),
+      stopRequested(false),
+      iterations(0),
+      currentEnergy(std::numeric_limits<double>::infinity()),
+      elapsedBefore(0.0),
+      checkpointInterval(0.0),
+      lastCheckpoint(0.0),
+      progressInterval(0.0),
+      lastProgress(0.0),
+      cancellation(nullptr),
+      snapDenominator(0),
+      snapGrid(false),
+      materializeInterval(0),
+      lastMaterialize(0),
+      targetRatio(-1.0),
+      targetObtuse(-1),
+      timeToTarget(-1.0),
+      lastObtuse(-1),
+      convergenceSum(0.0),
+      convergenceSteps(0),
+      telemetryCapacity(0),
+      telemetryStride(1),
+      telemetrySeen(0),
+      latest() {
+}
+
+double SearchControl::elapsed() const {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+    return elapsedBefore + elapsed.count();
+}
+
+double SearchControl::remaining() const {
+    return std::max(0.0, timeLimit - elapsed());
+}
+
+bool SearchControl::timeExceeded() const {
+    return elapsed() > timeLimit;
+}
+
+bool SearchControl::shouldStop() const {
+    if (stopRequested || timeExceeded()) return true;
+    if (cancellation != nullptr && *cancellation) return true;
+    if (incumbent == nullptr) return false;
+    if (incumbent->stop) return true;
+
+    // Give every engine half of the budget before comparing it to the others
+    if (elapsed() < LOSER_GRACE * timeLimit) return false;
+
+    double best = incumbent->bestEnergy;
+    return currentEnergy - best > LOSER_MARGIN * std::max(best, 1.0);
+}
+
+double SearchControl::energy(int obtuseCount, int steinerCount) const {
+    return a * obtuseCount + b * steinerCount;
+}
+
+void SearchControl::begin(int obtuseCount, int steinerCount) {
+    updateEnergy(energy(obtuseCount, steinerCount));
+
+    // Engines that continue another one (ortho, tiles) begin again, the target stays that of the first call
+    if (targetRatio >= 0.0 && targetObtuse < 0) {
+        targetObtuse = static_cast<int>(targetRatio * obtuseCount);
+    }
+    checkTarget(obtuseCount);
+    lastObtuse = obtuseCount;
+    record(obtuseCount, steinerCount);
+}
+
+void SearchControl::report(int obtuseCount, int steinerCount) {
+    iterations++;
+    updateEnergy(energy(obtuseCount, steinerCount));
+    checkTarget(obtuseCount);
+
+    // Step n of the rate is counted from 1 before the first step, as the engines did
+    if (lastObtuse > 0 && obtuseCount > 0) {
+        double n = iterations + 1;
+        convergenceSum += std::abs(std::log(static_cast<double>(obtuseCount) / lastObtuse) / std::log((n + 1) / n));
+        convergenceSteps++;
+    }
+    lastObtuse = obtuseCount;
+    record(obtuseCount, steinerCount);
+
+    if (checkpoint && elapsed() - lastCheckpoint >= checkpointInterval) {
+        lastCheckpoint = elapsed();
+        checkpoint();
+    }
+
+    if (progress && elapsed() - lastProgress >= progressInterval) {
+        lastProgress = elapsed();
+        progress(*this);
+    }
+}
+
+void SearchControl::updateEnergy(double value) {
+    currentEnergy = value;
+    if (incumbent == nullptr) return;
+
+    double best = incumbent->bestEnergy;
+    while (currentEnergy < best && !incumbent->bestEnergy.compare_exchange_weak(best, currentEnergy)) {
+    }
+}
+
+void SearchControl::checkTarget(int obtuseCount) {
+    if (targetObtuse >= 0 && timeToTarget < 0.0 && obtuseCount <= targetObtuse) {
+        timeToTarget = elapsed();
+    }
+}
+
+void SearchControl::record(int obtuseCount, int steinerCount) {
+    if (telemetryCapacity <= 0) return;
+
+    latest = { elapsed(), iterations, obtuseCount, steinerCount, currentEnergy };
+    if (telemetrySeen++ % telemetryStride != 0) return;
+    telemetry.push_back(latest);
+
+    // Halve the resolution so that the samples keep covering the whole run
+    if (static_cast<int>(telemetry.size()) >= telemetryCapacity) {
+        for (size_t i = 0; 2 * i < telemetry.size(); ++i) {
+            telemetry[i] = telemetry[2 * i];
+        }
+        telemetry.resize((telemetry.size() + 1) / 2);
+        telemetryStride *= 2;
+    }
+}
+
+void SearchControl::setTelemetry(int capacity) {
+    telemetryCapacity = capacity > 0 ? std::max(capacity, 2) : 0;
+    telemetryStride = 1;
+    telemetrySeen = 0;
+    telemetry.clear();
+}
+
+std::vector<TelemetrySample> SearchControl::getTelemetry() const {
+    std::vector<TelemetrySample> samples = telemetry;
+    if (telemetrySeen > 0 && (samples.empty() || samples.back().elapsed != latest.elapsed)) {
+        samples.push_back(latest);
+    }
+    return samples;
+}
+
+double SearchControl::getConvergenceRate() const {
+    return convergenceSteps > 0 ? convergenceSum / convergenceSteps : 0.0;
+}
+
+void SearchControl::requestStop() {
+    stopRequested = true;
+}
+
+void SearchControl::resume(double elapsedBefore, int iterationsBefore) {
+    this->elapsedBefore = elapsedBefore;
+    iterations = iterationsBefore;
+    lastCheckpoint = elapsedBefore;
+}
+
+void SearchControl::setCheckpoint(std::function<void()> callback, double interval) {
+    checkpoint = callback;
+    checkpointInterval = interval;
+    lastCheckpoint = elapsed();
+}
+
+void SearchControl::setSnapping(long denominator, bool grid) {
+    snapDenominator = denominator;
+    snapGrid = grid;
+}
+
+bool SearchControl::snap(const Point& p, Point& snapped) const {
+    if (snapDenominator <= 0) return false;
+    snapped = TriangulationUtils::snapPoint(p, snapDenominator, snapGrid);
+    return snapped != p;
+}
+
+void SearchControl::setMaterializeInterval(int interval) {
+    materializeInterval = interval;
+    lastMaterialize = iterations;
+}
+
+bool SearchControl::materializeDue() {
+    if (materializeInterval <= 0 || iterations - lastMaterialize < materializeInterval) return false;
+    lastMaterialize = iterations;
+    return true;
+}
+
+void SearchControl::setTarget(double ratio) {
+    targetRatio = ratio;
+    targetObtuse = -1;
+    timeToTarget = -1.0;
+}
+
+bool SearchControl::memoryUsage(long& rssKb, long& peakKb) {
+    std::ifstream status("/proc/self/status");
+    if (!status) return false;
+
+    bool rssFound = false, peakFound = false;
+    std::string line;
+    while (std::getline(status, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == "VmRSS:") rssFound = static_cast<bool>(fields >> rssKb);
+        else if (key == "VmHWM:") peakFound = static_cast<bool>(fields >> peakKb);
+    }
+    return rssFound && peakFound;
+}
+
+void SearchControl::setProgress(std::function<void(const SearchControl&)> callback, double interval) {
+    progress = callback;
+    progressInterval = interval;
+}
+
+void SearchControl::setLog(LogCallback callback) {
+    logCallback = callback;
+}
+
+void SearchControl::setCancellation(const std::atomic<bool>* flag) {
+    cancellation = flag;
+}
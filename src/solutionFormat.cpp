@@ -0,0 +1,406 @@
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <gmpxx.h>
+#include "solutionFormat.hpp"
+#include "jsonUtils.hpp"
+
+// File layout version, bump when the layout changes
+#define SOLUTION_MAGIC "OTSL"
+#define SOLUTION_VERSION 1
+
+// Members stored in their own section, the rest of the solution goes to the last block
+enum SolutionSection : uint8_t {
+    CONTENT_TYPE = 1 << 0,
+    INSTANCE_UID = 1 << 1,
+    STEINER_POINTS = 1 << 2,
+    EDGES = 1 << 3,
+    OBTUSE_COUNT = 1 << 4,
+    STATS = 1 << 5,
+};
+
+// Spelling of a coordinate
+enum CoordinateTag : uint8_t {
+    JSON_INTEGER = 0,
+    INTEGER_STRING = 1,
+    RATIONAL_STRING = 2,
+    VERBATIM = 3,
+};
+
+template <class T>
+static void writeValue(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+static T readValue(std::istream& in) {
+    T value;
+    if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+        throw std::runtime_error("Truncated solution");
+    }
+    return value;
+}
+
+static void writeVarint(std::ostream& out, uint64_t value) {
+    for (; value >= 0x80; value >>= 7) {
+        writeValue<uint8_t>(out, static_cast<uint8_t>(value | 0x80));
+    }
+    writeValue<uint8_t>(out, static_cast<uint8_t>(value));
+}
+
+static uint64_t readVarint(std::istream& in) {
+    uint64_t value = 0;
+    for (int shift = 0; ; shift += 7) {
+        uint8_t byte = readValue<uint8_t>(in);
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return value;
+        if (shift > 56) throw std::runtime_error("Corrupt varint in solution");
+    }
+}
+
+// Bytes left in the stream, unknown for streams that cannot seek
+static uint64_t remainingBytes(std::istream& in) {
+    std::streampos position = in.tellg();
+    if (position < 0) return std::numeric_limits<uint64_t>::max();
+    in.seekg(0, std::ios::end);
+    std::streampos end = in.tellg();
+    in.seekg(position);
+    return end > position ? static_cast<uint64_t>(end - position) : 0;
+}
+
+// Length or count of items of at least one byte each. A corrupt file must not make the reader
+// allocate more than the file holds, so it is checked before anything is allocated for it
+static uint64_t checkLength(std::istream& in, uint64_t length) {
+    if (length > remainingBytes(in)) {
+        throw std::runtime_error("Corrupt length in solution");
+    }
+    return length;
+}
+
+static uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Integers that fit in 64 bits with a sign, as nlohmann parses them
+static bool isInteger64(const nlohmann::json& value) {
+    if (value.is_number_unsigned()) {
+        return value.get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    }
+    return value.is_number_integer();
+}
+
+static nlohmann::json integerJson(int64_t value) {
+    return value < 0 ? nlohmann::json(value) : nlohmann::json(static_cast<uint64_t>(value));
+}
+
+// Sign and byte count in one varint, then the magnitude in big-endian bytes
+static void writeInteger(std::ostream& out, const mpz_class& value) {
+    std::vector<unsigned char> bytes((mpz_sizeinbase(value.get_mpz_t(), 2) + 7) / 8);
+    size_t count = 0;
+    mpz_export(bytes.data(), &count, 1, 1, 1, 0, value.get_mpz_t());
+    writeVarint(out, (static_cast<uint64_t>(count) << 1) | (sgn(value) < 0 ? 1 : 0));
+    out.write(reinterpret_cast<const char*>(bytes.data()), count);
+}
+
+static mpz_class readInteger(std::istream& in) {
+    uint64_t header = readVarint(in);
+    size_t count = checkLength(in, header >> 1);
+    std::vector<unsigned char> bytes(count);
+    if (!in.read(reinterpret_cast<char*>(bytes.data()), count)) {
+        throw std::runtime_error("Truncated solution");
+    }
+    mpz_class value;
+    mpz_import(value.get_mpz_t(), count, 1, 1, 1, 0, bytes.data());
+    return (header & 1) ? mpz_class(-value) : value;
+}
+
+// Parses a decimal integer that prints back exactly as text, so "+1" or "007" are refused
+static bool parseCanonical(const std::string& text, mpz_class& value) {
+    return !text.empty() && value.set_str(text, 10) == 0 && value.get_str() == text;
+}
+
+void SolutionFormat::writeString(std::ostream& out, const std::string& value) {
+    writeVarint(out, value.size());
+    out.write(value.data(), value.size());
+}
+
+std::string SolutionFormat::readString(std::istream& in) {
+    uint64_t size = checkLength(in, readVarint(in));
+    std::string value(size, '\0');
+    if (!in.read(&value[0], size)) {
+        throw std::runtime_error("Truncated solution");
+    }
+    return value;
+}
+
+void SolutionFormat::writeCoordinate(std::ostream& out, const nlohmann::json& value) {
+    if (isInteger64(value)) {
+        writeValue<uint8_t>(out, JSON_INTEGER);
+        writeInteger(out, mpz_class(static_cast<long>(value.get<int64_t>())));
+        return;
+    }
+
+    if (value.is_string()) {
+        const std::string& text = value.get_ref<const std::string&>();
+        size_t slash = text.find('/');
+        mpz_class num, den;
+        if (slash == std::string::npos && parseCanonical(text, num)) {
+            writeValue<uint8_t>(out, INTEGER_STRING);
+            writeInteger(out, num);
+            return;
+        }
+        if (slash != std::string::npos && parseCanonical(text.substr(0, slash), num) && parseCanonical(text.substr(slash + 1), den)) {
+            writeValue<uint8_t>(out, RATIONAL_STRING);
+            writeInteger(out, num);
+            writeInteger(out, den);
+            return;
+        }
+    }
+
+    writeValue<uint8_t>(out, VERBATIM);
+    writeBlock(out, value);
+}
+
+FT SolutionFormat::readExactCoordinate(std::istream& in) {
+    switch (readValue<uint8_t>(in)) {
+    case JSON_INTEGER:
+    case INTEGER_STRING:
+        return FT(FT::ET(readInteger(in)));
+    case RATIONAL_STRING: {
+        mpz_class num = readInteger(in);
+        FT::ET rational(num, readInteger(in));
+        rational.canonicalize();
+        return FT(rational);
+    }
+    case VERBATIM:
+        return JsonUtils::parseRational(readBlock(in));
+    default:
+        throw std::runtime_error("Unknown coordinate in solution");
+    }
+}
+
+nlohmann::json SolutionFormat::readCoordinate(std::istream& in) {
+    switch (readValue<uint8_t>(in)) {
+    case JSON_INTEGER: {
+        mpz_class value = readInteger(in);
+        if (!value.fits_slong_p()) throw std::runtime_error("Coordinate out of range in solution");
+        return integerJson(value.get_si());
+    }
+    case INTEGER_STRING:
+        return readInteger(in).get_str();
+    case RATIONAL_STRING: {
+        std::string num = readInteger(in).get_str();
+        return num + "/" + readInteger(in).get_str();
+    }
+    case VERBATIM:
+        return readBlock(in);
+    default:
+        throw std::runtime_error("Unknown coordinate in solution");
+    }
+}
+
+void SolutionFormat::writeBlock(std::ostream& out, const nlohmann::json& value) {
+    std::vector<uint8_t> cbor = nlohmann::json::to_cbor(value);
+    writeVarint(out, cbor.size());
+    out.write(reinterpret_cast<const char*>(cbor.data()), cbor.size());
+}
+
+nlohmann::json SolutionFormat::readBlock(std::istream& in) {
+    std::vector<uint8_t> cbor(checkLength(in, readVarint(in)));
+    if (!in.read(reinterpret_cast<char*>(cbor.data()), cbor.size())) {
+        throw std::runtime_error("Truncated solution");
+    }
+    return nlohmann::json::from_cbor(cbor);
+}
+
+bool SolutionFormat::isBinary(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    char magic[4];
+    return in.read(magic, 4) && std::string(magic, 4) == SOLUTION_MAGIC;
+}
+
+void SolutionFormat::write(const std::string& filename, const nlohmann::json& solution) {
+    if (!solution.is_object()) {
+        throw std::runtime_error("Solution is not a JSON object");
+    }
+
+    nlohmann::json rest = solution;
+    uint8_t sections = 0;
+    if (solution.contains("content_type") && solution["content_type"].is_string()) sections |= CONTENT_TYPE;
+    if (solution.contains("instance_uid") && solution["instance_uid"].is_string()) sections |= INSTANCE_UID;
+    if (solution.contains("obtuse_count") && isInteger64(solution["obtuse_count"])) sections |= OBTUSE_COUNT;
+    if (solution.contains("stats")) sections |= STATS;
+
+    const nlohmann::json* xs = solution.contains("steiner_points_x") ? &solution["steiner_points_x"] : nullptr;
+    const nlohmann::json* ys = solution.contains("steiner_points_y") ? &solution["steiner_points_y"] : nullptr;
+    if (xs && ys && xs->is_array() && ys->is_array() && xs->size() == ys->size()) {
+        sections |= STEINER_POINTS;
+        rest.erase("steiner_points_x");
+        rest.erase("steiner_points_y");
+    }
+
+    // Edges are pairs of vertex indices, anything else stays in the rest block
+    const nlohmann::json* edges = solution.contains("edges") ? &solution["edges"] : nullptr;
+    if (edges && edges->is_array()) {
+        bool pairs = true;
+        for (const auto& edge : *edges) {
+            if (!edge.is_array() || edge.size() != 2 || !isInteger64(edge[0]) || !isInteger64(edge[1])) {
+                pairs = false;
+                break;
+            }
+        }
+        if (pairs) {
+            sections |= EDGES;
+            rest.erase("edges");
+        }
+    }
+    if (sections & CONTENT_TYPE) rest.erase("content_type");
+    if (sections & INSTANCE_UID) rest.erase("instance_uid");
+    if (sections & OBTUSE_COUNT) rest.erase("obtuse_count");
+    if (sections & STATS) rest.erase("stats");
+
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Cannot write solution " + filename);
+    }
+    out.write(SOLUTION_MAGIC, 4);
+    writeValue<uint32_t>(out, SOLUTION_VERSION);
+    writeValue<uint8_t>(out, sections);
+
+    if (sections & CONTENT_TYPE) writeString(out, solution["content_type"]);
+    if (sections & INSTANCE_UID) writeString(out, solution["instance_uid"]);
+    if (sections & OBTUSE_COUNT) writeVarint(out, zigzag(solution["obtuse_count"].get<int64_t>()));
+
+    if (sections & STEINER_POINTS) {
+        writeVarint(out, xs->size());
+        for (size_t i = 0; i < xs->size(); ++i) {
+            writeCoordinate(out, (*xs)[i]);
+            writeCoordinate(out, (*ys)[i]);
+        }
+    }
+
+    // The first vertex relative to the first vertex of the previous edge, the second relative to the first;
+    // unsigned arithmetic wraps, so every pair of 64-bit indices survives the round trip
+    if (sections & EDGES) {
+        writeVarint(out, edges->size());
+        uint64_t previous = 0;
+        for (const auto& edge : *edges) {
+            uint64_t a = static_cast<uint64_t>(edge[0].get<int64_t>());
+            uint64_t b = static_cast<uint64_t>(edge[1].get<int64_t>());
+            writeVarint(out, zigzag(static_cast<int64_t>(a - previous)));
+            writeVarint(out, zigzag(static_cast<int64_t>(b - a)));
+            previous = a;
+        }
+    }
+
+    if (sections & STATS) writeBlock(out, solution["stats"]);
+    writeBlock(out, rest);
+
+    if (!out) {
+        throw std::runtime_error("Cannot write solution " + filename);
+    }
+}
+
+uint8_t SolutionFormat::readHeader(std::istream& in, const std::string& filename) {
+    char magic[4];
+    if (!in.read(magic, 4) || std::string(magic, 4) != SOLUTION_MAGIC) {
+        throw std::runtime_error(filename + " is not a binary solution");
+    }
+    if (readValue<uint32_t>(in) != SOLUTION_VERSION) {
+        throw std::runtime_error("Unsupported solution version in " + filename);
+    }
+    return readValue<uint8_t>(in);
+}
+
+nlohmann::json SolutionFormat::read(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open solution file " + filename);
+    }
+    uint8_t sections = readHeader(in, filename);
+
+    nlohmann::json solution = nlohmann::json::object();
+    if (sections & CONTENT_TYPE) solution["content_type"] = readString(in);
+    if (sections & INSTANCE_UID) solution["instance_uid"] = readString(in);
+    if (sections & OBTUSE_COUNT) solution["obtuse_count"] = integerJson(unzigzag(readVarint(in)));
+
+    if (sections & STEINER_POINTS) {
+        uint64_t count = checkLength(in, readVarint(in));
+        nlohmann::json xs = nlohmann::json::array();
+        nlohmann::json ys = nlohmann::json::array();
+        for (uint64_t i = 0; i < count; ++i) {
+            xs.push_back(readCoordinate(in));
+            ys.push_back(readCoordinate(in));
+        }
+        solution["steiner_points_x"] = std::move(xs);
+        solution["steiner_points_y"] = std::move(ys);
+    }
+
+    if (sections & EDGES) {
+        uint64_t count = checkLength(in, readVarint(in));
+        nlohmann::json edges = nlohmann::json::array();
+        uint64_t previous = 0;
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t a = previous + static_cast<uint64_t>(unzigzag(readVarint(in)));
+            uint64_t b = a + static_cast<uint64_t>(unzigzag(readVarint(in)));
+            edges.push_back({ integerJson(static_cast<int64_t>(a)), integerJson(static_cast<int64_t>(b)) });
+            previous = a;
+        }
+        solution["edges"] = std::move(edges);
+    }
+
+    if (sections & STATS) solution["stats"] = readBlock(in);
+    nlohmann::json rest = readBlock(in);
+    for (auto& member : rest.items()) {
+        solution[member.key()] = std::move(member.value());
+    }
+    return solution;
+}
+
+nlohmann::json SolutionFormat::load(const std::string& filename) {
+    if (isBinary(filename)) {
+        return read(filename);
+    }
+
+    std::ifstream in(filename);
+    if (!in) {
+        throw std::runtime_error("Cannot open solution file " + filename);
+    }
+    nlohmann::json solution;
+    in >> solution;
+    return solution;
+}
+
+std::vector<Point> SolutionFormat::readSteinerPoints(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open solution file " + filename);
+    }
+    uint8_t sections = readHeader(in, filename);
+    // Without a Steiner section the coordinates are either absent or malformed
+    if (!(sections & STEINER_POINTS)) {
+        nlohmann::json solution = read(filename);
+        if (solution.contains("steiner_points_x") || solution.contains("steiner_points_y")) {
+            throw std::runtime_error("Steiner coordinate lists differ in length in " + filename);
+        }
+        return {};
+    }
+    if (sections & CONTENT_TYPE) readString(in);
+    if (sections & INSTANCE_UID) readString(in);
+    if (sections & OBTUSE_COUNT) readVarint(in);
+
+    uint64_t count = checkLength(in, readVarint(in));
+    std::vector<Point> steiner_points;
+    steiner_points.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        FT x = readExactCoordinate(in);
+        FT y = readExactCoordinate(in);
+        steiner_points.emplace_back(x, y);
+    }
+    return steiner_points;
+}
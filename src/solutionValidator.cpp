@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <set>
+#include <thread>
+#include "solutionValidator.hpp"
+#include "jsonUtils.hpp"
+#include "triangulationUtils.hpp"
+
+static std::pair<int, int> edge_key(int a, int b) {
+    return a < b ? std::make_pair(a, b) : std::make_pair(b, a);
+}
+
+bool SolutionValidator::segmentCovered(const std::vector<Point>& points, int a, int b, const std::set<std::pair<int, int>>& edges, std::string& missing) {
+    std::vector<int> chain;
+    for (int i = 0; i < static_cast<int>(points.size()); ++i) {
+        if (i == a || i == b) continue;
+        if (CGAL::collinear(points[a], points[b], points[i]) && CGAL::collinear_are_strictly_ordered_along_line(points[a], points[i], points[b])) {
+            chain.push_back(i);
+        }
+    }
+    std::sort(chain.begin(), chain.end(), [&](int lhs, int rhs) {
+        return CGAL::has_smaller_distance_to_point(points[a], points[lhs], points[rhs]);
+    });
+    chain.insert(chain.begin(), a);
+    chain.push_back(b);
+
+    for (size_t i = 0; i + 1 < chain.size(); ++i) {
+        if (edges.count(edge_key(chain[i], chain[i + 1])) == 0) {
+            missing = std::to_string(chain[i]) + "-" + std::to_string(chain[i + 1]);
+            return false;
+        }
+    }
+    return true;
+}
+
+ValidationReport SolutionValidator::validate(const InputData& input_data, const nlohmann::json& solution, int threads, bool strict) {
+    auto start = std::chrono::steady_clock::now();
+    ValidationReport report;
+    auto fail = [&report](const std::string& message) {
+        report.valid = false;
+        report.errors.push_back(message);
+        return report;
+    };
+
+    if (solution.value("instance_uid", "") != input_data.instance_uid) {
+        return fail("Solution belongs to instance " + solution.value("instance_uid", std::string("?")));
+    }
+
+    // Points: the input points followed by the Steiner points, all exact with no lazy history
+    std::vector<Point> points;
+    for (size_t i = 0; i < input_data.points_x.size(); ++i) {
+        points.push_back(TriangulationUtils::exactPoint(Point(input_data.points_x[i], input_data.points_y[i])));
+    }
+    const auto& steiner_x = solution.at("steiner_points_x");
+    const auto& steiner_y = solution.at("steiner_points_y");
+    if (steiner_x.size() != steiner_y.size()) {
+        return fail("steiner_points_x and steiner_points_y differ in length");
+    }
+    for (size_t i = 0; i < steiner_x.size(); ++i) {
+        points.push_back(TriangulationUtils::exactPoint(Point(JsonUtils::parseRational(steiner_x[i]), JsonUtils::parseRational(steiner_y[i]))));
+    }
+    report.points = points.size();
+
+    // The instance file is not checked by the reader, its indices have to name input points
+    int input_points = input_data.points_x.size();
+    for (int index : input_data.region_boundary) {
+        if (index < 0 || index >= input_points) {
+            return fail("Boundary index " + std::to_string(index) + " is out of range");
+        }
+    }
+    for (const auto& constraint : input_data.additional_constraints) {
+        if (constraint.size() != 2 || constraint[0] < 0 || constraint[1] < 0 || constraint[0] >= input_points || constraint[1] >= input_points) {
+            return fail("Invalid constraint " + nlohmann::json(constraint).dump());
+        }
+    }
+
+    std::map<Point, int> point_index;
+    for (int i = 0; i < report.points; ++i) {
+        if (!point_index.emplace(points[i], i).second) {
+            return fail("Points " + std::to_string(point_index[points[i]]) + " and " + std::to_string(i) + " coincide");
+        }
+    }
+
+    std::set<std::pair<int, int>> edges;
+    for (const auto& edge : solution.at("edges")) {
+        int a = edge.at(0), b = edge.at(1);
+        if (a < 0 || b < 0 || a >= report.points || b >= report.points || a == b) {
+            return fail("Invalid edge " + edge.dump());
+        }
+        edges.insert(edge_key(a, b));
+    }
+    report.edges = edges.size();
+
+    // Rebuild the mesh with every edge as a constraint, crossing edges make the insertion throw
+    CDT cdt;
+    cdt.insert(points.begin(), points.end());
+    std::vector<Vertex_handle> handles(report.points);
+    for (auto vit = cdt.finite_vertices_begin(); vit != cdt.finite_vertices_end(); ++vit) {
+        handles[point_index[vit->point()]] = vit;
+    }
+    try {
+        for (const auto& edge : edges) {
+            cdt.insert_constraint(handles[edge.first], handles[edge.second]);
+        }
+    } catch (const std::exception& e) {
+        return fail("Edges cross each other (" + std::string(e.what()) + ")");
+    }
+    for (const auto& edge : edges) {
+        if (!cdt.is_edge(handles[edge.first], handles[edge.second])) {
+            return fail("Edge " + std::to_string(edge.first) + "-" + std::to_string(edge.second) + " passes through another point");
+        }
+    }
+
+    // The boundary and the additional constraints may be split by Steiner points but not left out
+    std::string missing;
+    const auto& boundary_indices = input_data.region_boundary;
+    for (size_t i = 0; i < boundary_indices.size(); ++i) {
+        int a = boundary_indices[i], b = boundary_indices[(i + 1) % boundary_indices.size()];
+        if (!segmentCovered(points, a, b, edges, missing)) {
+            fail("Boundary segment " + std::to_string(a) + "-" + std::to_string(b) + " is missing edge " + missing);
+        }
+    }
+    for (const auto& constraint : input_data.additional_constraints) {
+        if (!segmentCovered(points, constraint[0], constraint[1], edges, missing)) {
+            fail("Constraint " + std::to_string(constraint[0]) + "-" + std::to_string(constraint[1]) + " is missing edge " + missing);
+        }
+    }
+
+    std::vector<Point> boundary;
+    for (int index : boundary_indices) {
+        boundary.push_back(points[index]);
+    }
+
+    // Faces are scored in shards, each thread only reads the mesh
+    std::vector<Face_handle> faces;
+    for (auto fit = cdt.finite_faces_begin(); fit != cdt.finite_faces_end(); ++fit) {
+        faces.push_back(fit);
+    }
+    report.faces = faces.size();
+
+    struct Shard {
+        int regionFaces = 0;
+        int obtuse = 0;
+        int regionObtuse = 0;
+        int uncovered = 0;   // faces inside the region with an edge the solution does not have
+    };
+    int shard_count = std::max(1, std::min<int>(threads, faces.size() / 1024 + 1));
+    std::vector<Shard> shards(shard_count);
+    std::vector<std::thread> workers;
+    // The shards share the vertex points. They were made exact above: the predicates fall back to
+    // exact arithmetic on right and degenerate angles, and evaluating a shared lazy point from
+    // several threads at once is a data race
+    for (int s = 0; s < shard_count; ++s) {
+        workers.emplace_back([&, s]() {
+            Shard& shard = shards[s];
+            for (size_t f = s; f < faces.size(); f += shard_count) {
+                Face_handle face = faces[f];
+                const Point& p = face->vertex(0)->point();
+                const Point& q = face->vertex(1)->point();
+                const Point& r = face->vertex(2)->point();
+                bool obtuse = CGAL::angle(p, q, r) == CGAL::OBTUSE || CGAL::angle(q, r, p) == CGAL::OBTUSE || CGAL::angle(r, p, q) == CGAL::OBTUSE;
+                bool inside = boundary.size() < 3
+                    || CGAL::bounded_side_2(boundary.begin(), boundary.end(), CGAL::centroid(p, q, r)) == CGAL::ON_BOUNDED_SIDE;
+
+                shard.obtuse += obtuse;
+                if (!inside) continue;
+                shard.regionFaces++;
+                shard.regionObtuse += obtuse;
+                if (!face->is_constrained(0) || !face->is_constrained(1) || !face->is_constrained(2)) {
+                    shard.uncovered++;
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    int uncovered = 0;
+    for (const auto& shard : shards) {
+        report.region_faces += shard.regionFaces;
+        report.obtuse_count += shard.obtuse;
+        report.region_obtuse_count += shard.regionObtuse;
+        uncovered += shard.uncovered;
+    }
+    if (uncovered > 0) {
+        fail(std::to_string(uncovered) + " faces inside the region are not triangles of the solution");
+    }
+
+    // Edges outside the region come from the hull faces the solver keeps around non-convex regions
+    int outside = 0;
+    for (const auto& edge : edges) {
+        Point middle = CGAL::midpoint(points[edge.first], points[edge.second]);
+        if (boundary.size() >= 3 && CGAL::bounded_side_2(boundary.begin(), boundary.end(), middle) == CGAL::ON_UNBOUNDED_SIDE) {
+            outside++;
+        }
+    }
+    if (outside > 0) {
+        std::string message = std::to_string(outside) + " edges lie outside the region";
+        if (strict) fail(message);
+        else report.warnings.push_back(message);
+    }
+
+    report.reported_obtuse_count = solution.value("obtuse_count", -1);
+    if (report.reported_obtuse_count >= 0 && report.reported_obtuse_count != report.obtuse_count) {
+        fail("Reported obtuse_count " + std::to_string(report.reported_obtuse_count) + ", the mesh has " + std::to_string(report.obtuse_count));
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    report.elapsed = elapsed.count();
+    return report;
+}
@@ -0,0 +1,73 @@
+#include <stdexcept>
+#include "solveApi.hpp"
+#include "solver.hpp"
+#include "jsonUtils.hpp"
+
+namespace opt_triangulation {
+
+// Every index must name one of the input points
+static void check_indices(const Span<int>& indices, std::size_t num_points, const char* name) {
+    for (int index : indices) {
+        if (index < 0 || static_cast<std::size_t>(index) >= num_points) {
+            throw std::invalid_argument(std::string(name) + " index " + std::to_string(index) + " is out of range");
+        }
+    }
+}
+
+Solution solve(const InstanceView& instance, const SolveOptions& options) {
+    if (instance.points_x.size() != instance.points_y.size()) {
+        throw std::invalid_argument("points_x and points_y differ in length");
+    }
+    if (instance.constraints.size() % 2 != 0) {
+        throw std::invalid_argument("constraints must hold pairs of indices");
+    }
+    check_indices(instance.region_boundary, instance.points_x.size(), "region_boundary");
+    check_indices(instance.constraints, instance.points_x.size(), "constraints");
+    for (size_t i = 0; i < instance.constraints.size(); i += 2) {
+        if (instance.constraints[i] == instance.constraints[i + 1]) {
+            throw std::invalid_argument("constraints index " + std::to_string(instance.constraints[i]) + " is joined to itself");
+        }
+    }
+
+    // The solver works on its own copy, coordinates are converted to the numbers of the exact kernel
+    InputData input_data;
+    input_data.instance_uid = instance.instance_uid;
+    input_data.num_points = instance.points_x.size();
+    for (size_t i = 0; i < instance.points_x.size(); ++i) {
+        input_data.points_x.push_back(FT(instance.points_x[i]));
+        input_data.points_y.push_back(FT(instance.points_y[i]));
+    }
+    input_data.region_boundary.assign(instance.region_boundary.begin(), instance.region_boundary.end());
+    input_data.num_constraints = instance.constraints.size() / 2;
+    for (size_t i = 0; i < instance.constraints.size(); i += 2) {
+        input_data.additional_constraints.push_back({ instance.constraints[i], instance.constraints[i + 1] });
+    }
+    input_data.method = options.method;
+    input_data.delaunay = options.delaunay;
+    input_data.parameters = options.parameters;
+    JsonUtils::readParameters(input_data);
+
+    OutputData output_data;
+    OptimizerResult result = perform_triangulation(input_data, output_data, RunOptions());
+
+    Solution solution;
+    solution.steiner_x = std::move(output_data.steiner_points_x);
+    solution.steiner_y = std::move(output_data.steiner_points_y);
+    solution.edges.reserve(2 * output_data.edges.size());
+    for (const auto& edge : output_data.edges) {
+        solution.edges.push_back(edge[0]);
+        solution.edges.push_back(edge[1]);
+    }
+
+    solution.stats.method = output_data.method;
+    solution.stats.parameters = output_data.parameters;
+    solution.stats.obtuse_count = output_data.obtuse_triangle_count;
+    solution.stats.steiner_count = solution.steiner_x.size();
+    solution.stats.iterations = result.iterations;
+    solution.stats.energy = result.energy;
+    solution.stats.convergence_rate = result.convergence_rate;
+    solution.stats.elapsed = result.elapsed;
+    return solution;
+}
+
+} // namespace opt_triangulation
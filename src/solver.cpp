@@ -0,0 +1,288 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <algorithm>
+#include <stdexcept>
+
+#include "solver.hpp"
+#include "jsonUtils.hpp"
+#include "triangulationUtils.hpp"
+#include "algorithms.hpp"
+#include "optimizer.hpp"
+#include "algorithmSelector.hpp"
+#include "checkpoint.hpp"
+#include "parameterTable.hpp"
+
+std::vector<Point> constructBoundary(const InputData& input_data) {
+    std::vector<Point> boundary;
+
+    for (int index : input_data.region_boundary) {
+        Point p(input_data.points_x[index], input_data.points_y[index]);
+        boundary.push_back(p);
+    }
+
+    return boundary;
+}
+
+
+OptimizerResult perform_triangulation(const InputData& instance_data, OutputData& output_data, const RunOptions& options) {
+    // Copy that the tuned parameters of the chosen engine are filled into
+    InputData input_data = instance_data;
+    CDT cdt;
+
+    std::vector<Point> points;
+    std::vector<Point> steinerPoints;
+    std::map<Point, int> point_indices;
+    std::vector<Vertex_handle> vertex_handles;
+
+    // Insert initial points
+    for (int i = 0; i < input_data.points_x.size(); ++i) {
+        Point p(input_data.points_x[i], input_data.points_y[i]);
+        Vertex_handle vh = cdt.insert(p);
+        points.push_back(p);
+        vertex_handles.push_back(vh);
+        point_indices[p] = static_cast<int>(i);
+    }
+
+    // Insert additional constraints
+    for (const auto& constraint : input_data.additional_constraints) {
+        int idx1 = constraint[0];
+        int idx2 = constraint[1];
+        cdt.insert_constraint(vertex_handles[idx1], vertex_handles[idx2]);
+    }
+
+    // before
+    //CGAL::draw(cdt);
+    int obtuse_triangle_count = TriangulationUtils::countObtuseTriangles(cdt);
+    log_message(options.log, "Number of obtuse triangles: ", obtuse_triangle_count);
+    int initial_obtuse_count = obtuse_triangle_count;
+
+    auto region_boundary = constructBoundary(input_data);
+    std::vector<std::pair<Point, Point>> constraints;
+    for (const auto& constraint : input_data.additional_constraints) {
+        Point p1(input_data.points_x[constraint[0]], input_data.points_y[constraint[0]]);
+        Point p2(input_data.points_x[constraint[1]], input_data.points_y[constraint[1]]);
+        constraints.emplace_back(p1, p2);
+    }
+
+    
+
+    // std::string category = TriangulationUtils::getCategory(region_boundary, constraints);
+    // std::string outputFilename = "../" + category + "_results_test_test.csv";
+
+    // std::ofstream outFile(outputFilename, std::ios::app);
+    // if (!outFile) {
+    //     std::cerr << "Error opening file: " << outputFilename << std::endl;
+    //     exit(1);
+    // }
+
+    //outFile << " test     Processing input: " << std::endl;
+
+
+    // Continue from an earlier solution or a suspended run, the points are inserted in bulk
+    Checkpoint resumed;
+    bool resuming = !options.resume.empty();
+    std::vector<Point> startPoints;
+    if (resuming) {
+        resumed = CheckpointUtils::readCheckpoint(options.resume);
+        if (resumed.instance_uid != input_data.instance_uid || resumed.num_points != static_cast<int>(input_data.points_x.size())) {
+            throw std::runtime_error("Checkpoint " + options.resume + " belongs to another instance");
+        }
+        startPoints = resumed.steiner_points;
+    } else if (!options.warm_start.empty()) {
+        startPoints = JsonUtils::parseSolutionSteinerPoints(options.warm_start);
+    }
+    // A resumed run keeps the engine of its checkpoint, otherwise an explicit method in the input selects
+    // the engine or the selector picks it from the instance features. The selector runs before the start
+    // points are inserted, its corpus samples describe bare instances
+    std::string algorithm = input_data.method;
+    if (resuming) {
+        algorithm = resumed.engine;
+    } else if (!OptimizerRegistry::contains(algorithm)) {
+        algorithm = AlgorithmSelector::select(cdt, region_boundary, constraints);
+    }
+
+    if (!startPoints.empty()) {
+        cdt.insert(startPoints.begin(), startPoints.end());
+        steinerPoints.insert(steinerPoints.end(), startPoints.begin(), startPoints.end());
+        log_message(options.log, "Starting from ", startPoints.size(), " Steiner points, obtuse triangles: ",
+                    TriangulationUtils::countObtuseTriangles(cdt));
+    }
+
+    if (!resuming && !options.params.is_null() && ParameterTable::apply(options.params, algorithm, input_data)) {
+        log_message(options.log, "Tuned parameters of ", algorithm, " for ", ParameterTable::category(input_data));
+    }
+
+    auto optimizer = OptimizerRegistry::create(algorithm, input_data);
+    if (resuming) {
+        if (!optimizer->resumable()) {
+            throw std::runtime_error("Engine " + algorithm + " of checkpoint " + options.resume + " cannot be resumed");
+        }
+        optimizer->restore(resumed.parameters, resumed.state);
+    }
+    double time_limit = input_data.time_limit > 0 ? input_data.time_limit : optimizer->defaultTimeLimit();
+    if (options.max_time > 0) {
+        time_limit = std::min(time_limit, options.max_time);
+    }
+    SearchControl control(time_limit, input_data.seed, input_data.alpha, input_data.beta);
+    control.setSnapping(input_data.snap_denominator, input_data.snap_grid);
+    control.setMaterializeInterval(input_data.materialize_every);
+    control.setCancellation(options.cancel);
+    control.setLog(options.log);
+    control.setTarget(input_data.target_ratio);
+    control.setTelemetry(input_data.stats ? input_data.stats_samples : 0);
+    if (options.progress) {
+        control.setProgress(options.progress, options.progress_interval);
+    }
+
+    // A resumed run only gets what is left of the time budget
+    if (resuming) {
+        std::istringstream rng_state(resumed.rng_state);
+        rng_state >> control.getRng();
+        control.resume(resumed.elapsed, resumed.iterations);
+    }
+
+    auto write_checkpoint = [&]() {
+        Checkpoint checkpoint;
+        checkpoint.instance_uid = input_data.instance_uid;
+        checkpoint.num_points = input_data.points_x.size();
+        checkpoint.engine = optimizer->name();
+        checkpoint.parameters = optimizer->parameters();
+        checkpoint.state = optimizer->state();
+        checkpoint.iterations = control.getIterations();
+        checkpoint.elapsed = control.elapsed();
+        std::ostringstream rng_state;
+        rng_state << control.getRng();
+        checkpoint.rng_state = rng_state.str();
+        checkpoint.steiner_points = steinerPoints;
+        CheckpointUtils::writeCheckpoint(options.checkpoint, checkpoint);
+    };
+    // Engines that cannot continue from a checkpoint do not write one
+    bool checkpointing = !options.checkpoint.empty() && optimizer->resumable();
+    if (checkpointing) {
+        control.setCheckpoint(write_checkpoint, options.checkpoint_interval);
+    } else if (!options.checkpoint.empty()) {
+        log_message(options.log, "Engine ", algorithm, " cannot be resumed, no checkpoint is written");
+    }
+
+    OptimizerResult result = optimizer->run(cdt, steinerPoints, control);
+    output_data.parameters = result.parameters;
+    algorithm = result.engine;
+    if (result.peak_rss_kb >= 0) {
+        log_message(options.log, "Memory: ", result.rss_kb, " kB resident, ", result.peak_rss_kb, " kB peak");
+    }
+
+    if (input_data.prune) {
+        int pruned = prune_steiner_points(cdt, steinerPoints);
+        log_message(options.log, "Removed Steiner points: ", pruned);
+    }
+
+    if (checkpointing) {
+        write_checkpoint();
+    }
+
+    // Without the Delaunay requirement edge flips remove obtuse triangles left by the engine. They come
+    // last, every insertion of an engine restores the Delaunay property and would undo them
+    if (!input_data.delaunay) {
+        int flips = flip_edges(cdt);
+        log_message(options.log, "Edge flips: ", flips, ", obtuse triangles: ", TriangulationUtils::countObtuseTriangles(cdt));
+    }
+
+    // this part is for the output edges
+    int next_index = input_data.points_x.size();  // Start Steiner indices after input points
+
+    // Steiner indices follow the order of steiner_points_x/y in the output
+    for (const auto& p : steinerPoints) {
+        // Check if the point already exists in the map (to avoid duplicates)
+        if (point_indices.find(p) == point_indices.end()) {
+            point_indices[p] = next_index++;  // Assign a new unique index
+        }
+    }
+
+
+  
+    // after
+    //CGAL::draw(cdt);
+    obtuse_triangle_count = TriangulationUtils::countObtuseTriangles(cdt);
+    //std::cout << "Number of obtuse triangles: " << obtuse_triangle_count << std::endl;
+
+    // Prepare output data
+    output_data.content_type = "CG_SHOP_2025_Solution";
+    output_data.instance_uid = input_data.instance_uid;
+    output_data.obtuse_triangle_count = obtuse_triangle_count;
+    //output_data.parameters = input_data.parameters;
+    output_data.method = algorithm;
+    output_data.randomization_used = false;
+
+    if (input_data.stats) {
+        output_data.stats = {
+            { "engine", result.engine },
+            { "num_points", input_data.points_x.size() },
+            { "initial_obtuse", initial_obtuse_count },
+            { "obtuse", obtuse_triangle_count },
+            { "steiner", steinerPoints.size() },
+            { "iterations", result.iterations },
+            { "elapsed", result.elapsed },
+            { "time_per_iteration", result.iterations > 0 ? result.elapsed / result.iterations : -1.0 },
+            { "target_obtuse", control.getTargetObtuse() },
+            { "time_to_target", result.time_to_target },
+            { "peak_rss_kb", result.peak_rss_kb },
+            { "convergence_rate", result.convergence_rate }
+        };
+
+        // Time series as columns, one entry per sample
+        nlohmann::json telemetry = { { "elapsed", nlohmann::json::array() }, { "iteration", nlohmann::json::array() },
+                                     { "obtuse", nlohmann::json::array() }, { "steiner", nlohmann::json::array() },
+                                     { "energy", nlohmann::json::array() } };
+        for (const auto& sample : result.telemetry) {
+            telemetry["elapsed"].push_back(sample.elapsed);
+            telemetry["iteration"].push_back(sample.iteration);
+            telemetry["obtuse"].push_back(sample.obtuseCount);
+            telemetry["steiner"].push_back(sample.steinerCount);
+            telemetry["energy"].push_back(sample.energy);
+        }
+        output_data.stats["telemetry"] = telemetry;
+    }
+
+    // Steiner points x and y coordinates
+    for (const auto& p : steinerPoints) {
+        std::stringstream ss_x, ss_y;
+
+        // fix ergasia 1 mistake
+        auto exact_x = CGAL::exact(p.x());
+        ss_x << exact_x.get_num() << "/" << exact_x.get_den();
+        output_data.steiner_points_x.push_back(ss_x.str());
+
+        auto exact_y = CGAL::exact(p.y());
+        ss_y << exact_y.get_num() << "/" << exact_y.get_den();
+        output_data.steiner_points_y.push_back(ss_y.str());
+   
+    }
+
+    // Edges
+    for (auto eit = cdt.finite_edges_begin(); eit != cdt.finite_edges_end(); ++eit) {
+        auto face = eit->first;
+        int index = eit->second;
+
+        auto vh1 = face->vertex((index + 1) % 3);
+        auto vh2 = face->vertex((index + 2) % 3);
+
+        Point p1 = vh1->point();
+        Point p2 = vh2->point();
+
+        //std::cout << p1 << " " << p2 << std::endl;
+
+        int idx1 = point_indices[p1];
+        int idx2 = point_indices[p2];
+
+        //std::cout << idx1 << " " << idx2 << std::endl;
+
+
+        output_data.edges.push_back({ idx1, idx2 });
+    }
+
+    return result;
+}
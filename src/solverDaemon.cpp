@@ -0,0 +1,303 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "solverDaemon.hpp"
+#include "solver.hpp"
+#include "jsonUtils.hpp"
+
+using json = nlohmann::json;
+
+// Milliseconds between checks for a shutdown request while waiting for clients
+#define ACCEPT_POLL_MS 200
+
+SolverDaemon::Connection::~Connection() {
+    close(fd);
+}
+
+void SolverDaemon::Connection::send(const json& event) {
+    std::string line = event.dump() + "\n";
+    std::lock_guard<std::mutex> lock(writeMutex);
+    size_t written = 0;
+    while (open && written < line.size()) {
+        ssize_t n = ::send(fd, line.data() + written, line.size() - written, MSG_NOSIGNAL);
+        if (n <= 0) {
+            open = false;
+            break;
+        }
+        written += n;
+    }
+}
+
+SolverDaemon::SolverDaemon(const std::string& socketPath, int workers, const nlohmann::json& params)
+    : socketPath(socketPath), workerCount(std::max(workers, 1)), params(params), listenFd(-1), stopping(false), sequence(0) {
+}
+
+int SolverDaemon::run() {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path too long: " << socketPath << std::endl;
+        return 1;
+    }
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(socketPath.c_str());
+    if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(listenFd, 64) < 0) {
+        std::cerr << "Cannot listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    std::cout << "Serving on " << socketPath << " with " << workerCount << " workers" << std::endl;
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&SolverDaemon::workerLoop, this);
+    }
+
+    std::vector<std::pair<std::shared_ptr<Connection>, std::thread>> connections;
+    while (!stopping) {
+        // Threads of clients that left are joined on every poll, not only when the next client arrives
+        for (auto it = connections.begin(); it != connections.end();) {
+            if (it->first->finished) {
+                it->second.join();
+                it = connections.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        pollfd pending = { listenFd, POLLIN, 0 };
+        if (poll(&pending, 1, ACCEPT_POLL_MS) <= 0) continue;
+
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) continue;
+
+        auto connection = std::make_shared<Connection>(fd);
+        connections.emplace_back(connection, std::thread(&SolverDaemon::serveConnection, this, connection));
+    }
+
+    close(listenFd);
+    unlink(socketPath.c_str());
+
+    // Running jobs stop with their best solution, which still reaches the client
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& entry : jobs) {
+            entry.second->cancelled = true;
+        }
+        for (auto& job : queue) {
+            job->connection->send({ { "event", "cancelled" }, { "id", job->id } });
+            jobs.erase(job->id);
+        }
+        queue.clear();
+    }
+    available.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (auto& entry : connections) {
+        shutdown(entry.first->fd, SHUT_RDWR);
+        entry.second.join();
+    }
+    return 0;
+}
+
+void SolverDaemon::serveConnection(std::shared_ptr<Connection> connection) {
+    std::string buffer;
+    char chunk[4096];
+
+    while (connection->open) {
+        ssize_t n = recv(connection->fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) break;
+        buffer.append(chunk, n);
+
+        size_t end;
+        while ((end = buffer.find('\n')) != std::string::npos) {
+            std::string line = buffer.substr(0, end);
+            buffer.erase(0, end + 1);
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+            try {
+                handleRequest(connection, json::parse(line));
+            } catch (const std::exception& e) {
+                connection->send({ { "event", "error" }, { "message", e.what() } });
+            }
+        }
+    }
+
+    // Nobody is left to receive the results of this client
+    cancelAll(connection);
+    connection->open = false;
+    connection->finished = true;
+}
+
+void SolverDaemon::handleRequest(const std::shared_ptr<Connection>& connection, const json& request) {
+    std::string op = request.value("op", "");
+
+    if (op == "solve") {
+        submit(connection, request);
+    } else if (op == "cancel") {
+        cancel(connection, request.at("id").get<std::string>());
+    } else if (op == "priority") {
+        std::string id = request.at("id").get<std::string>();
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = jobs.find(id);
+        if (it == jobs.end() || it->second->running) {
+            connection->send({ { "event", "error" }, { "id", id }, { "message", "No queued job with this id" } });
+            return;
+        }
+        it->second->priority = request.at("priority").get<int>();
+        connection->send({ { "event", "queued" }, { "id", id }, { "priority", it->second->priority } });
+    } else if (op == "status") {
+        std::lock_guard<std::mutex> lock(mutex);
+        json running = json::array();
+        for (const auto& entry : jobs) {
+            if (entry.second->running) running.push_back(entry.first);
+        }
+        connection->send({ { "event", "status" }, { "queued", queue.size() }, { "running", running }, { "workers", workerCount } });
+    } else if (op == "shutdown") {
+        stopping = true;
+    } else {
+        connection->send({ { "event", "error" }, { "message", "Unknown op: " + op } });
+    }
+}
+
+void SolverDaemon::submit(const std::shared_ptr<Connection>& connection, const json& request) {
+    auto job = std::make_shared<Job>();
+    job->connection = connection;
+    job->input = JsonUtils::parseInput(request.at("instance"));
+    job->priority = request.value("priority", 0);
+    job->progress = request.value("progress", false);
+
+    double deadline = request.value("deadline", 0.0);
+    if (deadline > 0) {
+        job->hasDeadline = true;
+        job->deadline = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(deadline));
+    }
+
+    size_t position;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job->sequence = sequence++;
+        job->id = request.value("id", "job-" + std::to_string(job->sequence));
+        if (jobs.count(job->id) > 0) {
+            connection->send({ { "event", "error" }, { "id", job->id }, { "message", "A job with this id is already queued or running" } });
+            return;
+        }
+        jobs[job->id] = job;
+        queue.push_back(job);
+        position = queue.size();
+    }
+    available.notify_one();
+    connection->send({ { "event", "queued" }, { "id", job->id }, { "priority", job->priority }, { "position", position } });
+}
+
+void SolverDaemon::cancel(const std::shared_ptr<Connection>& connection, const std::string& id) {
+    std::shared_ptr<Job> job;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = jobs.find(id);
+        if (it == jobs.end()) {
+            connection->send({ { "event", "error" }, { "id", id }, { "message", "No queued or running job with this id" } });
+            return;
+        }
+        job = it->second;
+        job->cancelled = true;
+        if (job->running) return; // The worker reports the best solution so far
+
+        queue.erase(std::remove(queue.begin(), queue.end(), job), queue.end());
+        jobs.erase(it);
+    }
+    job->connection->send({ { "event", "cancelled" }, { "id", id } });
+}
+
+void SolverDaemon::cancelAll(const std::shared_ptr<Connection>& connection) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = jobs.begin(); it != jobs.end();) {
+        std::shared_ptr<Job> job = it->second;
+        if (job->connection != connection) {
+            ++it;
+            continue;
+        }
+        job->cancelled = true;
+        if (job->running) {
+            ++it;
+        } else {
+            queue.erase(std::remove(queue.begin(), queue.end(), job), queue.end());
+            it = jobs.erase(it);
+        }
+    }
+}
+
+std::shared_ptr<SolverDaemon::Job> SolverDaemon::takeNextJob() {
+    auto urgent = [](const std::shared_ptr<Job>& lhs, const std::shared_ptr<Job>& rhs) {
+        if (lhs->priority != rhs->priority) return lhs->priority > rhs->priority;
+        if (lhs->hasDeadline != rhs->hasDeadline) return lhs->hasDeadline;
+        if (lhs->hasDeadline && lhs->deadline != rhs->deadline) return lhs->deadline < rhs->deadline;
+        return lhs->sequence < rhs->sequence;
+    };
+    auto next = std::min_element(queue.begin(), queue.end(), urgent);
+    std::shared_ptr<Job> job = *next;
+    queue.erase(next);
+    return job;
+}
+
+void SolverDaemon::workerLoop() {
+    while (true) {
+        std::shared_ptr<Job> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this]() { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            job = takeNextJob();
+            job->running = true;
+        }
+
+        runJob(job);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.erase(job->id);
+    }
+}
+
+void SolverDaemon::runJob(const std::shared_ptr<Job>& job) {
+    RunOptions options;
+    options.cancel = &job->cancelled;
+    options.params = params;
+
+    if (job->hasDeadline) {
+        std::chrono::duration<double> left = job->deadline - std::chrono::steady_clock::now();
+        if (left.count() <= 0) {
+            job->connection->send({ { "event", "expired" }, { "id", job->id } });
+            return;
+        }
+        options.max_time = left.count();
+    }
+
+    if (job->progress) {
+        std::shared_ptr<Job> observed = job;
+        options.progress = [observed](const SearchControl& control) {
+            observed->connection->send({ { "event", "progress" }, { "id", observed->id }, { "elapsed", control.elapsed() },
+                                         { "iterations", control.getIterations() }, { "energy", control.getCurrentEnergy() } });
+        };
+    }
+
+    job->connection->send({ { "event", "started" }, { "id", job->id } });
+
+    OutputData output_data;
+    try {
+        OptimizerResult result = perform_triangulation(job->input, output_data, options);
+        job->connection->send({ { "event", job->cancelled ? "cancelled" : "done" }, { "id", job->id },
+                                { "elapsed", result.elapsed }, { "solution", JsonUtils::toJson(output_data) } });
+    } catch (const std::exception& e) {
+        job->connection->send({ { "event", "error" }, { "id", job->id }, { "message", e.what() } });
+    }
+}
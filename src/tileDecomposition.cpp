@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <set>
+#include <utility>
+#include "tileDecomposition.hpp"
+#include "triangulationUtils.hpp"
+
+std::vector<TileDecomposition::Tile> TileDecomposition::partition(const CDT& cdt, int maxFaces, std::map<Face_handle, int>& tileOf) {
+    std::vector<Face_handle> faces;
+    for (auto fit = cdt.finite_faces_begin(); fit != cdt.finite_faces_end(); ++fit) {
+        faces.push_back(fit);
+    }
+
+    std::vector<Tile> tiles;
+    split(faces, maxFaces, tiles, tileOf);
+    return tiles;
+}
+
+std::vector<TileDecomposition::Tile> TileDecomposition::clusters(const CDT& cdt, int halo, int maxFaces, std::map<Face_handle, int>& tileOf) {
+    // Every obtuse face starts its own cluster and claims the faces up to halo rings around it
+    std::map<Face_handle, int> label;
+    std::vector<int> parent;
+    std::vector<Face_handle> frontier;
+    for (auto fit = cdt.finite_faces_begin(); fit != cdt.finite_faces_end(); ++fit) {
+        if (TriangulationUtils::isObtuseTriangle(fit->vertex(0)->point(), fit->vertex(1)->point(), fit->vertex(2)->point())) {
+            label[fit] = parent.size();
+            parent.push_back(parent.size());
+            frontier.push_back(fit);
+        }
+    }
+
+    for (int ring = 0; ring < halo && !frontier.empty(); ++ring) {
+        std::vector<Face_handle> next;
+        for (const auto& face : frontier) {
+            for (int i = 0; i < 3; ++i) {
+                Face_handle neighbor = face->neighbor(i);
+                if (cdt.is_infinite(neighbor) || label.count(neighbor)) continue;
+                label[neighbor] = label[face];
+                next.push_back(neighbor);
+            }
+        }
+        frontier.swap(next);
+    }
+
+    // Clusters whose faces share an edge would change each other, they are solved together
+    auto find = [&parent](int cluster) {
+        while (parent[cluster] != cluster) {
+            parent[cluster] = parent[parent[cluster]];
+            cluster = parent[cluster];
+        }
+        return cluster;
+    };
+    for (const auto& entry : label) {
+        for (int i = 0; i < 3; ++i) {
+            auto neighbor = label.find(entry.first->neighbor(i));
+            if (neighbor != label.end()) {
+                parent[find(entry.second)] = find(neighbor->second);
+            }
+        }
+    }
+
+    std::map<int, std::vector<Face_handle>> members;
+    for (const auto& entry : label) {
+        members[find(entry.second)].push_back(entry.first);
+    }
+
+    // Clusters above maxFaces are cut like the tiles of partition
+    std::vector<Tile> tiles;
+    for (const auto& cluster : members) {
+        split(cluster.second, maxFaces, tiles, tileOf);
+    }
+    return tiles;
+}
+
+void TileDecomposition::split(const std::vector<Face_handle>& faces, int maxFaces, std::vector<Tile>& tiles, std::map<Face_handle, int>& tileOf) {
+    std::vector<std::pair<double, double>> centroids;
+    for (const auto& face : faces) {
+        double x = 0.0, y = 0.0;
+        for (int i = 0; i < 3; ++i) {
+            x += CGAL::to_double(face->vertex(i)->point().x());
+            y += CGAL::to_double(face->vertex(i)->point().y());
+        }
+        centroids.emplace_back(x / 3.0, y / 3.0);
+    }
+
+    std::vector<int> order(faces.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+
+    // Ranges of order still to be split, cut across the longer side of their bounding box
+    std::vector<std::pair<int, int>> ranges;
+    if (!order.empty()) ranges.emplace_back(0, order.size());
+    maxFaces = std::max(maxFaces, 1);
+
+    while (!ranges.empty()) {
+        auto range = ranges.back();
+        ranges.pop_back();
+        int begin = range.first, end = range.second;
+
+        if (end - begin > maxFaces) {
+            double minX = centroids[order[begin]].first, maxX = minX;
+            double minY = centroids[order[begin]].second, maxY = minY;
+            for (int i = begin; i < end; ++i) {
+                minX = std::min(minX, centroids[order[i]].first);
+                maxX = std::max(maxX, centroids[order[i]].first);
+                minY = std::min(minY, centroids[order[i]].second);
+                maxY = std::max(maxY, centroids[order[i]].second);
+            }
+            bool vertical = maxX - minX >= maxY - minY;
+            int middle = begin + (end - begin) / 2;
+            std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&](int lhs, int rhs) {
+                return vertical ? centroids[lhs].first < centroids[rhs].first : centroids[lhs].second < centroids[rhs].second;
+            });
+            ranges.emplace_back(begin, middle);
+            ranges.emplace_back(middle, end);
+            continue;
+        }
+
+        Tile tile;
+        for (int i = begin; i < end; ++i) {
+            Face_handle face = faces[order[i]];
+            tileOf[face] = tiles.size();
+            tile.faces.push_back(face);
+            if (TriangulationUtils::isObtuseTriangle(face->vertex(0)->point(), face->vertex(1)->point(), face->vertex(2)->point())) {
+                tile.obtuseCount++;
+            }
+        }
+        tiles.push_back(tile);
+    }
+}
+
+int TileDecomposition::tileIndex(const CDT& cdt, const std::map<Face_handle, int>& tileOf, Face_handle face) {
+    if (cdt.is_infinite(face)) return -1;
+    auto it = tileOf.find(face);
+    return it != tileOf.end() ? it->second : -1;
+}
+
+CDT TileDecomposition::extractTile(const CDT& cdt, const std::vector<Tile>& tiles, int tile, const std::map<Face_handle, int>& tileOf) {
+    std::set<Vertex_handle> vertices;
+    std::vector<Point> points;
+    std::vector<std::pair<Point, Point>> constraints;
+
+    for (const auto& face : tiles[tile].faces) {
+        for (int i = 0; i < 3; ++i) {
+            Vertex_handle v = face->vertex(i);
+            if (vertices.insert(v).second) {
+                points.push_back(TriangulationUtils::exactPoint(v->point()));
+            }
+
+            // Border edges are seen from one side only, inner constrained edges from both
+            Face_handle other = face->neighbor(i);
+            int otherTile = tileIndex(cdt, tileOf, other);
+            bool border = otherTile != tile;
+            if (border || (face->is_constrained(i) && face < other)) {
+                constraints.emplace_back(face->vertex(cdt.cw(i))->point(), face->vertex(cdt.ccw(i))->point());
+            }
+        }
+    }
+
+    CDT tileCdt;
+    tileCdt.insert(points.begin(), points.end());
+    for (const auto& constraint : constraints) {
+        tileCdt.insert_constraint(TriangulationUtils::exactPoint(constraint.first), TriangulationUtils::exactPoint(constraint.second));
+    }
+    return tileCdt;
+}
+
+bool TileDecomposition::owns(const CDT& cdt, int tile, const std::map<Face_handle, int>& tileOf, const Point& p) {
+    CDT::Locate_type type;
+    int index;
+    Face_handle face = cdt.locate(p, type, index);
+
+    if (type == CDT::FACE) return tileIndex(cdt, tileOf, face) == tile;
+    if (type == CDT::EDGE) {
+        return tileIndex(cdt, tileOf, face) == tile || tileIndex(cdt, tileOf, face->neighbor(index)) == tile;
+    }
+    return false;
+}
@@ -0,0 +1,49 @@
+#include <algorithm>
+#include "trialArena.hpp"
+
+TrialArena::TrialArena(std::size_t chunkSize) : chunkSize(chunkSize), chunk(0), offset(0) {
+}
+
+void* TrialArena::allocate(std::size_t bytes, std::size_t alignment) {
+    while (chunk < chunks.size()) {
+        std::size_t start = (offset + alignment - 1) / alignment * alignment;
+        if (start + bytes <= sizes[chunk]) {
+            offset = start + bytes;
+            return chunks[chunk].get() + start;
+        }
+        // Move on to the next chunk kept from an earlier trial
+        chunk++;
+        offset = 0;
+    }
+
+    // new[] returns memory aligned for any fundamental type
+    std::size_t size = std::max(chunkSize, bytes);
+    chunks.emplace_back(new char[size]);
+    sizes.push_back(size);
+    chunk = chunks.size() - 1;
+    offset = bytes;
+    return chunks[chunk].get();
+}
+
+void TrialArena::reset() {
+    chunk = 0;
+    offset = 0;
+}
+
+std::size_t TrialArena::capacity() const {
+    std::size_t total = 0;
+    for (auto size : sizes) {
+        total += size;
+    }
+    return total;
+}
+
+TrialArena*& TrialArena::current() {
+    thread_local TrialArena* arena = nullptr;
+    return arena;
+}
+
+TrialArena& TrialArena::local() {
+    thread_local TrialArena arena;
+    return arena;
+}
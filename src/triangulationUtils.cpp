@@ -1,6 +1,5 @@
 #include "triangulation.hpp"
 #include "triangulationUtils.hpp"
-#include <CGAL/draw_triangulation_2.h>
 #include <CGAL/convex_hull_2.h>
 #include <CGAL/Polygon_2.h>
 
@@ -65,6 +64,34 @@ int TriangulationUtils::findObtuseAngle(const Point& p1, const Point& p2, const
         return -1; // No obtuse angle
     }
 
+bool TriangulationUtils::obtuseProjection(const Point& p1, const Point& p2, const Point& p3, Point& projection) {
+    int obtuse_index = TriangulationUtils::findObtuseAngle(p1, p2, p3);
+    if (obtuse_index == -1) return false; // No obtuse angle
+
+    // Project the obtuse vertex onto the line through the opposite edge
+    if (obtuse_index == 0) {
+        projection = Line(p3, p2).projection(p1);
+    } else if (obtuse_index == 1) {
+        projection = Line(p3, p1).projection(p2);
+    } else {
+        projection = Line(p2, p1).projection(p3);
+    }
+    return true;
+}
+
+Point TriangulationUtils::longestEdgeMidpoint(const Point& p1, const Point& p2, const Point& p3) {
+    FT d1 = TriangulationUtils::squaredDistance(p1, p2);
+    FT d2 = TriangulationUtils::squaredDistance(p2, p3);
+    FT d3 = TriangulationUtils::squaredDistance(p3, p1);
+
+    if (d1 >= d2 && d1 >= d3) {
+        return CGAL::midpoint(p1, p2); // Longest edge is between p1 and p2
+    } else if (d2 >= d1 && d2 >= d3) {
+        return CGAL::midpoint(p2, p3); // Longest edge is between p2 and p3
+    }
+    return CGAL::midpoint(p3, p1);     // Longest edge is between p3 and p1
+}
+
 bool TriangulationUtils::is_point_inside_convex_hull(const CDT& cdt, const Point& point) {
     std::vector<Point> vertices;
     for (auto vit = cdt.finite_vertices_begin(); vit != cdt.finite_vertices_end(); ++vit) {
@@ -114,6 +141,13 @@ FT TriangulationUtils::computeHeight(const Triangle& triangle) {
 }
 
 Face_handle TriangulationUtils::getRandomObtuseTriangle(const CDT& cdt) {
+    static std::random_device rd;  // Seed
+    static std::mt19937 gen(rd()); // Random number generator
+
+    return TriangulationUtils::getRandomObtuseTriangle(cdt, gen);
+}
+
+Face_handle TriangulationUtils::getRandomObtuseTriangle(const CDT& cdt, std::mt19937& gen) {
     // Collect all obtuse triangles
     std::vector<Face_handle> obtuseTriangles;
     for (auto face = cdt.finite_faces_begin(); face != cdt.finite_faces_end(); ++face) {
@@ -129,8 +163,6 @@ Face_handle TriangulationUtils::getRandomObtuseTriangle(const CDT& cdt) {
     }
 
     // Choose a random obtuse triangle
-    static std::random_device rd;  // Seed
-    static std::mt19937 gen(rd()); // Random number generator
     std::uniform_int_distribution<> dis(0, obtuseTriangles.size() - 1);
 
     return obtuseTriangles[dis(gen)];
@@ -187,7 +219,7 @@ std::string TriangulationUtils::classifyInput(const std::vector<Point>& boundary
     } else {
         if (isAxisParallel) {
             //std::cout << "Non-convex boundary, axis-parallel segments " << std::endl;
-            return "ls"; // Non-convex boundary, axis-parallel segments
+            return "ortho"; // Non-convex boundary, axis-parallel segments
         } else {
             //std::cout << "Irregular non-convex boundary " << std::endl;
             return "ls"; // Irregular non-convex boundary
@@ -220,4 +252,47 @@ std::string TriangulationUtils::getCategory(const std::vector<Point>& boundary,
             return "Non_Convex_Irregular"; // Irregular non-convex boundary
         }
     }
-}
\ No newline at end of file
+}
+FT TriangulationUtils::snapCoordinate(const FT& value, long maxDenominator, bool grid) {
+    const auto& exact = CGAL::exact(value);
+    mpz_class limit(maxDenominator);
+    if (exact.get_den() <= limit) return value;
+
+    if (grid) {
+        // floor(value * maxDenominator + 1/2) / maxDenominator
+        FT::ET scaled = exact * limit + FT::ET(1, 2);
+        mpz_class rounded;
+        mpz_fdiv_q(rounded.get_mpz_t(), scaled.get_num_mpz_t(), scaled.get_den_mpz_t());
+        FT::ET snapped(rounded, limit);
+        snapped.canonicalize();
+        return FT(snapped);
+    }
+
+    // Continued fraction convergents up to the bound, then the better of the last convergent and semiconvergent
+    mpz_class p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+    mpz_class n = exact.get_num(), d = exact.get_den();
+    while (true) {
+        mpz_class a;
+        mpz_fdiv_q(a.get_mpz_t(), n.get_mpz_t(), d.get_mpz_t());
+        mpz_class q2 = q0 + a * q1;
+        if (q2 > limit) break;
+        mpz_class p2 = p0 + a * p1;
+        p0 = p1; q0 = q1; p1 = p2; q1 = q2;
+        mpz_class r = n - a * d;
+        n = d; d = r;
+    }
+    mpz_class k = (limit - q0) / q1;
+    FT::ET bound1(p0 + k * p1, q0 + k * q1);
+    FT::ET bound2(p1, q1);
+    bound1.canonicalize();
+    bound2.canonicalize();
+    return FT(abs(bound2 - exact) <= abs(bound1 - exact) ? bound2 : bound1);
+}
+
+Point TriangulationUtils::snapPoint(const Point& p, long maxDenominator, bool grid) {
+    return Point(snapCoordinate(p.x(), maxDenominator, grid), snapCoordinate(p.y(), maxDenominator, grid));
+}
+
+Point TriangulationUtils::exactPoint(const Point& p) {
+    return Point(FT(CGAL::exact(p.x())), FT(CGAL::exact(p.y())));
+}
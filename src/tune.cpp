@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "jsonUtils.hpp"
+#include "parameterTable.hpp"
+#include "parameterTuner.hpp"
+
+namespace fs = std::filesystem;
+
+static std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+// Instance files among paths, directories are searched for *.json files with points
+static std::vector<std::string> instance_files(const std::vector<std::string>& paths) {
+    std::vector<std::string> files;
+    for (const auto& path : paths) {
+        if (!fs::is_directory(path)) {
+            files.push_back(path);
+            continue;
+        }
+        for (const auto& entry : fs::directory_iterator(path)) {
+            if (entry.path().extension() != ".json") continue;
+            std::ifstream file(entry.path());
+            nlohmann::json instance;
+            try {
+                file >> instance;
+            } catch (const std::exception&) {
+                continue;
+            }
+            if (instance.contains("instance_uid") && instance.contains("points_x")) {
+                files.push_back(entry.path().string());
+            }
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+int main(int argc, const char* argv[]) {
+    TuningOptions options;
+    options.threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string output_filename;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-o" && has_value) output_filename = argv[++i];
+        else if (arg == "--engines" && has_value) options.engines = split(argv[++i]);
+        else if (arg == "--configurations" && has_value) options.configurations = std::stoi(argv[++i]);
+        else if (arg == "--run-time" && has_value) options.run_time = std::stod(argv[++i]);
+        else if (arg == "--budget" && has_value) options.cpu_budget = std::stod(argv[++i]);
+        else if (arg == "--min-instances" && has_value) options.min_instances = std::stoi(argv[++i]);
+        else if (arg == "--threads" && has_value) options.threads = std::stoi(argv[++i]);
+        else if (arg == "--seed" && has_value) options.seed = std::stoul(argv[++i]);
+        else paths.push_back(arg);
+    }
+
+    if (output_filename.empty() || paths.empty()) {
+        std::cout << "Usage: " << argv[0] << " -o <table.json> [--engines ls,sa,ant] [--configurations <count>]"
+                  << " [--run-time <seconds>] [--budget <CPU seconds>] [--min-instances <count>]"
+                  << " [--threads <count>] [--seed <seed>] <instances dir or files>..." << std::endl;
+        return 1;
+    }
+
+    std::vector<InputData> instances;
+    for (const auto& file : instance_files(paths)) {
+        instances.push_back(JsonUtils::parseInputJson(file));
+    }
+    std::cerr << "Tuning " << options.engines.size() << " engines on " << instances.size() << " instances with "
+              << options.threads << " threads, budget " << options.cpu_budget << " CPU seconds" << std::endl;
+
+    // The solver reports every run on stdout, the races report on stderr
+    std::cout.setstate(std::ios::failbit);
+    ParameterTuner tuner(options);
+    nlohmann::json table = tuner.tune(instances);
+    std::cout.clear();
+
+    ParameterTable::write(output_filename, table);
+    std::cout << table.dump(4) << std::endl;
+    std::cout << "Spent " << tuner.getSpent() << " CPU seconds, table written to " << output_filename << std::endl;
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+
+#include "jsonUtils.hpp"
+#include "solutionValidator.hpp"
+#include "solutionFormat.hpp"
+
+namespace fs = std::filesystem;
+
+static nlohmann::json read_json(const fs::path& path) {
+    std::ifstream file(path);
+    nlohmann::json value;
+    file >> value;
+    return value;
+}
+
+// Prints the verdict of a solution that could not be validated
+static bool fail(const fs::path& solution_path, const std::string& error) {
+    std::cout << "FAIL " << solution_path.filename().string() << std::endl;
+    std::cout << "     error: " << error << std::endl;
+    return false;
+}
+
+// Validate one solution, prints a line per file and returns false if it is invalid
+static bool check(const InputData& input_data, const nlohmann::json& solution, const fs::path& solution_path, int threads, bool strict) {
+    ValidationReport report;
+    try {
+        report = SolutionValidator::validate(input_data, solution, threads, strict);
+    } catch (const std::exception& e) {
+        report.valid = false;
+        report.errors.push_back(e.what());
+    }
+
+    std::cout << (report.valid ? "OK   " : "FAIL ") << solution_path.filename().string();
+    if (report.valid) {
+        std::cout << "  points " << report.points << ", edges " << report.edges << ", obtuse " << report.obtuse_count
+                  << " (" << report.region_obtuse_count << " in the region), " << report.elapsed << "s";
+    }
+    std::cout << std::endl;
+    for (const auto& error : report.errors) {
+        std::cout << "     error: " << error << std::endl;
+    }
+    for (const auto& warning : report.warnings) {
+        std::cout << "     warning: " << warning << std::endl;
+    }
+    return report.valid;
+}
+
+int main(int argc, const char* argv[]) {
+    int threads = std::max(1u, std::thread::hardware_concurrency());
+    bool strict = false;
+    bool directories = false;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) threads = std::stoi(argv[++i]);
+        else if (arg == "--strict") strict = true;
+        else if (arg == "--dir") directories = true;
+        else paths.push_back(arg);
+    }
+
+    if (paths.size() != 2) {
+        std::cout << "Usage: " << argv[0] << " [--threads <count>] [--strict] <instance.json> <solution.json|solution.bin>" << std::endl;
+        std::cout << "       " << argv[0] << " [--threads <count>] [--strict] --dir <instances> <solutions>" << std::endl;
+        return 1;
+    }
+
+    if (!directories) {
+        try {
+            return check(JsonUtils::parseInputJson(paths[0]), SolutionFormat::load(paths[1]), paths[1], threads, strict) ? 0 : 1;
+        } catch (const std::exception& e) {
+            fail(paths[1], e.what());
+            return 1;
+        }
+    }
+
+    // Solutions are matched to their instances by instance_uid
+    auto start = std::chrono::steady_clock::now();
+    std::map<std::string, fs::path> instances;
+    for (const auto& entry : fs::directory_iterator(paths[0])) {
+        if (entry.path().extension() != ".json") continue;
+        try {
+            nlohmann::json instance = read_json(entry.path());
+            if (instance.contains("instance_uid") && instance.contains("points_x")) {
+                instances[instance["instance_uid"]] = entry.path();
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Skipped " << entry.path().string() << ": " << e.what() << std::endl;
+        }
+    }
+
+    std::vector<fs::path> solutions;
+    for (const auto& entry : fs::directory_iterator(paths[1])) {
+        if (entry.path().extension() == ".json" || entry.path().extension() == ".bin") solutions.push_back(entry.path());
+    }
+    std::sort(solutions.begin(), solutions.end());
+
+    // Every instance is parsed once, on the first solution that refers to it
+    std::map<std::string, InputData> parsed;
+    int failed = 0;
+    for (const auto& solution_path : solutions) {
+        try {
+            nlohmann::json solution = SolutionFormat::load(solution_path.string());
+            std::string uid = solution.value("instance_uid", "");
+            auto instance = instances.find(uid);
+            if (instance == instances.end()) {
+                fail(solution_path, "no instance with uid " + uid);
+                failed++;
+                continue;
+            }
+            auto input_data = parsed.find(uid);
+            if (input_data == parsed.end()) {
+                input_data = parsed.emplace(uid, JsonUtils::parseInputJson(instance->second.string())).first;
+            }
+            if (!check(input_data->second, solution, solution_path, threads, strict)) {
+                failed++;
+            }
+        } catch (const std::exception& e) {
+            fail(solution_path, e.what());
+            failed++;
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << solutions.size() << " solutions, " << failed << " invalid, " << elapsed.count() << "s" << std::endl;
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,47 @@
+#include <iostream>
+#include <string>
+#include <CGAL/draw_triangulation_2.h>
+
+#include "triangulation.hpp"
+#include "jsonUtils.hpp"
+
+// Shows the triangulation of an instance, with the Steiner points of a solution if one is given
+int main(int argc, const char* argv[]) {
+    std::string input_filename;
+    std::string solution_filename;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "-i" && has_value) input_filename = argv[++i];
+        else if (arg == "-s" && has_value) solution_filename = argv[++i];
+        else {
+            input_filename.clear();
+            break;
+        }
+    }
+
+    if (input_filename.empty()) {
+        std::cout << "Usage: " << argv[0] << " -i <inputFile> [-s <solutionFile>]" << std::endl;
+        return 1;
+    }
+
+    InputData input_data = JsonUtils::parseInputJson(input_filename);
+
+    CDT cdt;
+    std::vector<Vertex_handle> vertex_handles;
+    for (size_t i = 0; i < input_data.points_x.size(); ++i) {
+        vertex_handles.push_back(cdt.insert(Point(input_data.points_x[i], input_data.points_y[i])));
+    }
+    for (const auto& constraint : input_data.additional_constraints) {
+        cdt.insert_constraint(vertex_handles[constraint[0]], vertex_handles[constraint[1]]);
+    }
+
+    if (!solution_filename.empty()) {
+        std::vector<Point> steinerPoints = JsonUtils::parseSolutionSteinerPoints(solution_filename);
+        cdt.insert(steinerPoints.begin(), steinerPoints.end());
+    }
+
+    CGAL::draw(cdt);
+    return 0;
+}